@@ -38,6 +38,23 @@ input_getc (void) {
 	return key;
 }
 
+/* Like input_getc(), but stores the key in *KEY and returns true,
+   or returns false if the running thread is interrupted with
+   thread_interrupt() before a key arrives. */
+bool
+input_getc_interruptible (uint8_t *key) {
+	enum intr_level old_level;
+	bool ok;
+
+	old_level = intr_disable ();
+	ok = intq_getc_interruptible (&buffer, key);
+	if (ok)
+		serial_notify ();
+	intr_set_level (old_level);
+
+	return ok;
+}
+
 /* Returns true if the input buffer is full,
    false otherwise.
    Interrupts must be off. */
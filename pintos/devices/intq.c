@@ -3,13 +3,14 @@
 #include "threads/thread.h"
 
 static int next (int pos);
-static void wait (struct intq *q, struct thread **waiter);
+static bool dequeue (struct intq *q, uint8_t *byte, bool interruptible);
+static void wait (struct intq *q, struct thread **waiter, bool interruptible);
 static void signal (struct intq *q, struct thread **waiter);
 
 /* Initializes interrupt queue Q. */
 void
 intq_init (struct intq *q) {
-	lock_init (&q->lock);
+	sema_init (&q->wait_sema, 1);
 	q->not_full = q->not_empty = NULL;
 	q->head = q->tail = 0;
 }
@@ -36,18 +37,43 @@ uint8_t
 intq_getc (struct intq *q) {
 	uint8_t byte;
 
+	if (!dequeue (q, &byte, false))
+		NOT_REACHED ();
+	return byte;
+}
+
+/* Like intq_getc(), but stores the byte in *BYTE and returns
+   true, or returns false without removing anything if the running
+   thread is interrupted with thread_interrupt() while it waits
+   for one. */
+bool
+intq_getc_interruptible (struct intq *q, uint8_t *byte) {
+	return dequeue (q, byte, true);
+}
+
+/* Removes a byte from Q into *BYTE, sleeping until there is one.
+   If INTERRUPTIBLE, returns false if thread_interrupt() cuts the
+   sleep short; otherwise always returns true. */
+static bool
+dequeue (struct intq *q, uint8_t *byte, bool interruptible) {
 	ASSERT (intr_get_level () == INTR_OFF);
 	while (intq_empty (q)) {
 		ASSERT (!intr_context ());
-		lock_acquire (&q->lock);
-		wait (q, &q->not_empty);
-		lock_release (&q->lock);
+		if (!interruptible)
+			sema_down (&q->wait_sema);
+		else if (!sema_down_interruptible (&q->wait_sema))
+			return false;
+		if (intq_empty (q))
+			wait (q, &q->not_empty, interruptible);
+		sema_up (&q->wait_sema);
+		if (interruptible && intq_empty (q) && thread_current ()->interrupted)
+			return false;
 	}
 
-	byte = q->buf[q->tail];
+	*byte = q->buf[q->tail];
 	q->tail = next (q->tail);
 	signal (q, &q->not_full);
-	return byte;
+	return true;
 }
 
 /* Adds BYTE to the end of Q.
@@ -59,9 +85,10 @@ intq_putc (struct intq *q, uint8_t byte) {
 	ASSERT (intr_get_level () == INTR_OFF);
 	while (intq_full (q)) {
 		ASSERT (!intr_context ());
-		lock_acquire (&q->lock);
-		wait (q, &q->not_full);
-		lock_release (&q->lock);
+		sema_down (&q->wait_sema);
+		if (intq_full (q))
+			wait (q, &q->not_full, false);
+		sema_up (&q->wait_sema);
 	}
 
 	q->buf[q->head] = byte;
@@ -76,16 +103,23 @@ next (int pos) {
 }
 
 /* WAITER must be the address of Q's not_empty or not_full
-   member.  Waits until the given condition is true. */
+   member.  Waits until the given condition is true, or, if
+   INTERRUPTIBLE, until thread_interrupt() wakes us. */
 static void
-wait (struct intq *q UNUSED, struct thread **waiter) {
+wait (struct intq *q UNUSED, struct thread **waiter, bool interruptible) {
 	ASSERT (!intr_context ());
 	ASSERT (intr_get_level () == INTR_OFF);
 	ASSERT ((waiter == &q->not_empty && intq_empty (q))
 			|| (waiter == &q->not_full && intq_full (q)));
 
 	*waiter = thread_current ();
-	thread_block ();
+	if (!interruptible)
+		thread_block ();
+	else {
+		thread_block_interruptible ();
+		if (*waiter == thread_current ())
+			*waiter = NULL;
+	}
 }
 
 /* WAITER must be the address of Q's not_empty or not_full
@@ -99,7 +133,10 @@ signal (struct intq *q UNUSED, struct thread **waiter) {
 			|| (waiter == &q->not_full && !intq_full (q)));
 
 	if (*waiter != NULL) {
-		thread_unblock (*waiter);
+		/* An interrupted waiter may already be ready to run, not
+		   yet having withdrawn itself. */
+		if ((*waiter)->status == THREAD_BLOCKED)
+			thread_unblock (*waiter);
 		*waiter = NULL;
 	}
 }
@@ -7,8 +7,10 @@
 
 #include "threads/interrupt.h"
 #include "threads/io.h"
+#include "threads/profile.h"
 #include "threads/synch.h"
 #include "threads/thread.h"
+#include "threads/workqueue.h"
 
 /* See [8254] for hardware details of the 8254 timer chip. */
 
@@ -22,54 +24,151 @@
 /* Number of timer ticks since OS booted. */
 static int64_t ticks;
 
-/* Number of loops per timer tick.
-   Initialized by timer_calibrate(). */
-static unsigned loops_per_tick;
+/* 8254 input frequency and the counter value for one tick,
+   rounded to nearest. */
+#define PIT_HZ 1193180
+#define PIT_TICK_COUNT ((PIT_HZ + TIMER_FREQ / 2) / TIMER_FREQ)
+
+/* If true, the idle thread stops the periodic tick while nothing
+   is due and programs a one-shot interrupt for the next timer
+   deadline instead.  Controlled by kernel command-line option
+   "-nohz". */
+bool timer_nohz;
+
+/* Dynamic tick state.  In NOHZ_IDLE the PIT is in one-shot mode
+   covering NOHZ_TICKS tick boundaries, the first of which is
+   NOHZ_FIRST counts after programming.  NOHZ_HR is a one-shot that
+   ends before the next tick boundary, for a sub-tick sleep; the
+   boundary is HR_LEFT counts after it.  NOHZ_RESYNC is a one-shot
+   that ends exactly on the next tick boundary, after which the
+   periodic mode is restored in phase with the old ticks. */
+enum nohz_state { NOHZ_OFF, NOHZ_IDLE, NOHZ_HR, NOHZ_RESYNC };
+static enum nohz_state nohz_state;
+static uint32_t nohz_first;      /* PIT counts to the first boundary. */
+static uint32_t nohz_programmed; /* PIT counts of the whole one-shot. */
+static int nohz_ticks;           /* Tick boundaries in the one-shot. */
+static uint32_t hr_left;         /* NOHZ_HR: counts from expiry to boundary. */
+static bool hr_expired;          /* Interrupt is a NOHZ_HR expiry, not a tick. */
+
+/* Threads blocked in hr_sleep().  All of them are woken by every
+   timer bottom half and recheck their own deadline. */
+static struct list hr_waiters;
+
+/* Sub-tick sleeps shorter than this spin on the TSC: blocking
+   and rescheduling would cost about as much as the wait. */
+#define TIMER_SPIN_NS 20000
+
+/* TSC clocksource.  timer_now_ns() = (TSC - TSC_BASE) * TSC_MULT
+   >> 32, i.e. TSC_MULT is nanoseconds per TSC cycle in 32.32 fixed
+   point.  Initialized by timer_calibrate(). */
+static uint64_t tsc_hz;
+static uint64_t tsc_base;
+static uint64_t tsc_mult;
+
+/* Hierarchical timer wheel (cf. [Varghese87]).
+   Level 0 has one slot per tick for the next TW0_SIZE ticks.  Each
+   higher level has TWN_SIZE slots, each covering a whole revolution
+   of the level below it; when the level below wraps around, one slot
+   of the higher level is "cascaded" down.  Insertion and removal are
+   O(1), and expiry pops one whole level-0 slot per tick. */
+#define TW0_BITS 8
+#define TWN_BITS 6
+#define TW0_SIZE (1 << TW0_BITS)
+#define TWN_SIZE (1 << TWN_BITS)
+#define TW0_MASK (TW0_SIZE - 1)
+#define TWN_MASK (TWN_SIZE - 1)
+#define TWN_LEVELS 4
+#define TW_MAX_DELTA ((1LL << (TW0_BITS + TWN_LEVELS * TWN_BITS)) - 1)
+
+static struct list tw0[TW0_SIZE];
+static struct list twn[TWN_LEVELS][TWN_SIZE];
+static int64_t wheel_tick; /* Next tick the wheel will process. */
+
+/* Bottom half of the timer interrupt: expires wheel timers and
+   runs the once-a-second MLFQS updates, MLFQS_SECONDS of which
+   are still owed (more than one after a tickless idle period). */
+static struct work timer_softirq;
+static int mlfqs_seconds;
 
 static intr_handler_func timer_interrupt;
-static bool too_many_loops(unsigned loops);
-static void busy_wait(int64_t loops);
 static void real_time_sleep(int64_t num, int32_t denom);
-static bool wake_tick_less(const struct list_elem *a, const struct list_elem *b, void *aux);
+static void hr_sleep(uint64_t deadline);
+static void hr_arm(uint32_t count);
+static void hr_wake(void);
+static uint32_t ns_to_pit(uint64_t ns);
+static inline uint64_t rdtsc(void);
+static void wheel_insert(struct timer *);
+static int wheel_cascade(int level);
+static void wheel_run(void);
+static int64_t wheel_next_event(int64_t horizon);
+static void timer_wakeup(void *thread_);
+static void timer_tick(void);
+static void timer_bottom_half(void *aux);
+static void pit_set_periodic(void);
+static void pit_set_oneshot(uint32_t count);
+static uint32_t pit_read_count(void);
+static bool pit_output_high(void);
 
 /* Sets up the 8254 Programmable Interval Timer (PIT) to
    interrupt PIT_FREQ times per second, and registers the
    corresponding interrupt. */
 void timer_init(void) {
-  /* 8254 input frequency divided by TIMER_FREQ, rounded to
-     nearest. */
-  uint16_t count = (1193180 + TIMER_FREQ / 2) / TIMER_FREQ;
+  pit_set_periodic();
 
-  outb(0x43, 0x34); /* CW: counter 0, LSB then MSB, mode 2, binary. */
-  outb(0x40, count & 0xff);
-  outb(0x40, count >> 8);
+  for (int i = 0; i < TW0_SIZE; i++) list_init(&tw0[i]);
+  for (int l = 0; l < TWN_LEVELS; l++)
+    for (int i = 0; i < TWN_SIZE; i++) list_init(&twn[l][i]);
+  wheel_tick = 0;
+  list_init(&hr_waiters);
+  work_init(&timer_softirq, timer_bottom_half, NULL);
 
   intr_register_ext(0x20, timer_interrupt, "8254 Timer");
 }
 
-/* Calibrates loops_per_tick, used to implement brief delays. */
+/* Calibrates the TSC against PIT counter 2, which runs from the
+   same 1.19318 MHz crystal as the tick but is gated through port
+   0x61 and can be polled without interrupts.  One 10 ms window is
+   enough: the PIT and TSC are read at the same edge, so the error
+   is a few TSC cycles per window. */
 void timer_calibrate(void) {
-  unsigned high_bit, test_bit;
+  const uint32_t count = PIT_HZ / 100; /* 10 ms. */
 
   ASSERT(intr_get_level() == INTR_ON);
   printf("Calibrating timer...  ");
 
-  /* Approximate loops_per_tick as the largest power-of-two
-     still less than one timer tick. */
-  loops_per_tick = 1u << 10;
-  while (!too_many_loops(loops_per_tick << 1)) {
-    loops_per_tick <<= 1;
-    ASSERT(loops_per_tick != 0);
-  }
+  enum intr_level old_level = intr_disable();
+  outb(0x61, (inb(0x61) & ~0x02) | 0x01); /* Gate 2 on, speaker off. */
+  outb(0x43, 0xb0); /* CW: counter 2, LSB then MSB, mode 0, binary. */
+  outb(0x42, count & 0xff);
+  outb(0x42, count >> 8);
+
+  uint64_t start = rdtsc();
+  while ((inb(0x61) & 0x20) == 0) continue; /* OUT2 goes high at 0. */
+  uint64_t cycles = rdtsc() - start;
+  intr_set_level(old_level);
 
-  /* Refine the next 8 bits of loops_per_tick. */
-  high_bit = loops_per_tick;
-  for (test_bit = high_bit >> 1; test_bit != high_bit >> 10; test_bit >>= 1)
-    if (!too_many_loops(high_bit | test_bit)) loops_per_tick |= test_bit;
+  tsc_hz = cycles * PIT_HZ / count;
+  ASSERT(tsc_hz > 0);
+  tsc_mult = (1000000000ULL << 32) / tsc_hz;
+  tsc_base = rdtsc();
 
-  printf("%'" PRIu64 " loops/s.\n", (uint64_t)loops_per_tick * TIMER_FREQ);
+  printf("%'" PRIu64 " MHz TSC.\n", tsc_hz / 1000000);
 }
 
+/* Returns the number of nanoseconds since timer_calibrate(),
+   read from the TSC.  Monotonic and much finer than a tick. */
+uint64_t timer_now_ns(void) {
+  uint64_t delta = rdtsc() - tsc_base;
+  return (uint64_t)(((unsigned __int128)delta * tsc_mult) >> 32);
+}
+
+/* Returns the raw time-stamp counter, for code that wants to
+   count cycles rather than nanoseconds. */
+uint64_t timer_cycles(void) { return rdtsc(); }
+
+/* Returns the TSC frequency measured by timer_calibrate(). */
+uint64_t timer_cycles_hz(void) { return tsc_hz; }
+
 /* Returns the number of timer ticks since the OS booted. */
 int64_t timer_ticks(void) {
   enum intr_level old_level = intr_disable();
@@ -90,17 +189,15 @@ void timer_sleep(int64_t ticks) {
   // edge case 처리 : tick가 0 이하라면?
   if (ticks <= 0) return;
 
-  // 현제 스레드 가져오기
-  struct thread *curr = thread_current();
-
-  // wake_tick 설정
-  curr->wake_tick = start + ticks;
+  // 깨어날 때까지 이 스택 프레임이 살아있으므로 timer를 지역 변수로 둔다
+  struct timer t;
+  timer_setup(&t, timer_wakeup, thread_current());
 
   // 인터럽트 끄기
   enum intr_level old_level = intr_disable();
 
-  // sleep_list에 추가
-  list_insert_ordered(get_sleep_list(), &curr->sleep_elem, wake_tick_less, NULL);
+  // timer wheel에 추가 (O(1))
+  timer_add(&t, start + ticks);
 
   // thread_block() 호출, 재 schedule 될 때까지 대기
   thread_block();
@@ -118,23 +215,139 @@ void timer_usleep(int64_t us) { real_time_sleep(us, 1000 * 1000); }
 /* Suspends execution for approximately NS nanoseconds. */
 void timer_nsleep(int64_t ns) { real_time_sleep(ns, 1000 * 1000 * 1000); }
 
+/* Initializes timer T to call FUNC(AUX) when it expires.  T is
+   not armed until passed to timer_add(). */
+void timer_setup(struct timer *t, timer_func *func, void *aux) {
+  ASSERT(t != NULL);
+  ASSERT(func != NULL);
+
+  t->func = func;
+  t->aux = aux;
+  t->expires = 0;
+  t->pending = false;
+}
+
+/* Arms T to expire at absolute tick EXPIRES.  If EXPIRES has
+   already passed, T fires on the next timer tick.  Re-adding a
+   pending timer moves it.  May be called from an interrupt
+   handler, including from a timer callback. */
+void timer_add(struct timer *t, int64_t expires) {
+  ASSERT(t != NULL);
+
+  enum intr_level old_level = intr_disable();
+  if (t->pending) list_remove(&t->elem);
+  t->expires = expires;
+  t->pending = true;
+  wheel_insert(t);
+  intr_set_level(old_level);
+}
+
+/* Disarms T.  Returns true if T was pending, false if it had
+   already fired or was never armed. */
+bool timer_cancel(struct timer *t) {
+  ASSERT(t != NULL);
+
+  enum intr_level old_level = intr_disable();
+  bool was_pending = t->pending;
+  if (was_pending) {
+    list_remove(&t->elem);
+    t->pending = false;
+  }
+  intr_set_level(old_level);
+  return was_pending;
+}
+
 /* Prints timer statistics. */
 void timer_print_stats(void) { printf("Timer: %" PRId64 " ticks\n", timer_ticks()); }
 
+/* Called by the idle thread, with interrupts off, right before it
+   halts.  In -nohz mode, if no timer is due for more than one tick,
+   replaces the periodic tick by a single one-shot interrupt on the
+   tick boundary of the next deadline.  The 16-bit PIT limits one
+   idle period to about 55 ms. */
+void timer_idle_enter(void) {
+  ASSERT(intr_get_level() == INTR_OFF);
+  if (!timer_nohz || nohz_state != NOHZ_OFF) return;
+  /* sub-tick으로 잠든 쓰레드는 다음 tick이 깨워야 한다 */
+  if (!list_empty(&hr_waiters)) return;
+
+  /* 다음 tick 경계까지 남은 count.  경계가 너무 가까우면 읽고
+     다시 프로그래밍하는 사이에 tick을 놓칠 수 있으므로 포기 */
+  uint32_t first = pit_read_count();
+  if (first < PIT_TICK_COUNT / 16) return;
+
+  int max_ticks = 1 + (0xffff - first) / PIT_TICK_COUNT;
+  int n = wheel_next_event(ticks + max_ticks) - ticks;
+  if (n <= 1) return;
+
+  nohz_first = first;
+  nohz_ticks = n;
+  nohz_programmed = first + (uint32_t)(n - 1) * PIT_TICK_COUNT;
+  pit_set_oneshot(nohz_programmed);
+  nohz_state = NOHZ_IDLE;
+}
+
+/* Called on entry to every external interrupt.  Leaves dynamic
+   tick mode: accounts the tick boundaries that passed while the
+   periodic interrupt was off, exactly as if they had been taken,
+   and puts the PIT back in periodic mode on the original phase. */
+void timer_idle_exit(void) {
+  if (nohz_state == NOHZ_OFF) return;
+
+  if (nohz_state == NOHZ_HR) {
+    /* sub-tick sleep의 one-shot 만료.  tick이 아니므로 세지 않고,
+       남은 count로 다음 tick 경계에 위상을 맞춘다. */
+    if (pit_output_high()) {
+      pit_set_oneshot(hr_left);
+      nohz_state = NOHZ_RESYNC;
+      hr_expired = true;
+    }
+    return;
+  }
+
+  if (pit_output_high()) {
+    /* one-shot 만료.  마지막 경계의 tick은 곧 실행될
+       timer_interrupt()가 센다. */
+    pit_set_periodic();
+    if (nohz_state == NOHZ_IDLE)
+      for (int i = 0; i < nohz_ticks - 1; i++) timer_tick();
+    nohz_state = NOHZ_OFF;
+    return;
+  }
+  if (nohz_state == NOHZ_RESYNC) return;
+
+  /* 다른 장치의 인터럽트로 일찍 깨어남.  지나간 경계만큼 tick을
+     따라잡고, 다음 경계에서 끝나는 one-shot으로 위상을 맞춘다. */
+  uint32_t elapsed = nohz_programmed - pit_read_count();
+  int crossed = elapsed < nohz_first ? 0 : 1 + (elapsed - nohz_first) / PIT_TICK_COUNT;
+  uint32_t left = nohz_first + (uint32_t)crossed * PIT_TICK_COUNT - elapsed;
+
+  for (int i = 0; i < crossed; i++) timer_tick();
+  pit_set_oneshot(left);
+  nohz_state = NOHZ_RESYNC;
+}
+
 /* Timer interrupt handler. */
-static void timer_interrupt(struct intr_frame *args UNUSED) {
+static void timer_interrupt(struct intr_frame *args) {
+  if (hr_expired) {
+    /* sub-tick sleep 만료: bottom half에서 hr_waiters만 깨운다 */
+    hr_expired = false;
+    softirq_raise(&timer_softirq);
+    return;
+  }
+  if (profile_enabled) profile_sample(args);
+  timer_tick();
+}
+
+/* Accounts one timer tick: advances the clock and charges the
+   running thread.  Expiring timers and the per-second MLFQS work
+   are left to timer_bottom_half(). */
+static void timer_tick(void) {
   ticks++;
   thread_tick();
 
-  // 잠든 쓰레드를 깨우자
-  while (!list_empty(get_sleep_list())) {
-    struct thread *sleep_thread = list_entry(list_front(get_sleep_list()), struct thread, sleep_elem);
-    if (sleep_thread->wake_tick > ticks)  // wake_tick이 흐른 시간보다 크다면, 아직 깨울 때가 아님
-      break;
-    //깨울 때라면
-    list_pop_front(get_sleep_list());
-    thread_unblock(sleep_thread);
-  }
+  // 만료된 timer 처리는 인터럽트를 끝낸 뒤 bottom half에서
+  softirq_raise(&timer_softirq);
 
   /* recent_cpu 증가 */
   if (thread_mlfqs) {  // mlqfs일 때만
@@ -147,47 +360,34 @@ static void timer_interrupt(struct intr_frame *args UNUSED) {
     if (ticks % 4 == 0) {
       // 원래 모든 쓰레드를 순회해야하지만, 어짜피 바뀐건 현재쓰레드의 recent_cpu밖에 없다.
       mlfqs_update_priority(thread_current());
-      if (thread_current()->priority <= max_priority_mlfqs_queue()) {
+      if (thread_current()->priority <= thread_max_ready_priority()) {
         intr_yield_on_return();  // 핸들러 내부이므로 핸들러끝나고 yield
       }
     }
-    /* load_avg 최신화 */
-    if (ticks % TIMER_FREQ == 0) {  // 1초 마다
-      thread_update_load_avg();
-      thread_update_all_recent_cpu();
-      thread_update_all_priority();
-    }
+    /* load_avg 최신화도 bottom half에서 */
+    if (ticks % TIMER_FREQ == 0) mlfqs_seconds++;  // 1초 마다
   }
 }
 
-/* Returns true if LOOPS iterations waits for more than one timer
-   tick, otherwise false. */
-static bool too_many_loops(unsigned loops) {
-  /* Wait for a timer tick. */
-  int64_t start = ticks;
-  while (ticks == start) barrier();
-
-  /* Run LOOPS loops. */
-  start = ticks;
-  busy_wait(loops);
+/* Bottom half of the timer interrupt, run with interrupts on
+   after the interrupt has been acknowledged. */
+static void timer_bottom_half(void *aux UNUSED) {
+  // 만료된 timer들의 callback 실행 (잠든 쓰레드 깨우기 포함)
+  wheel_run();
 
-  /* If the tick count changed, we iterated too long. */
-  barrier();
-  return start != ticks;
-}
-
-/* Iterates through a simple loop LOOPS times, for implementing
-   brief delays.
-
-   Marked NO_INLINE because code alignment can significantly
-   affect timings, so that if this function was inlined
-   differently in different places the results would be difficult
-   to predict. */
-static void NO_INLINE busy_wait(int64_t loops) {
-  while (loops-- > 0) barrier();
+  enum intr_level old_level = intr_disable();
+  hr_wake();
+  for (; mlfqs_seconds > 0; mlfqs_seconds--) {
+    thread_update_load_avg();
+    thread_mlfqs_decay();  // 실행 가능한 쓰레드만 갱신, 잠든 쓰레드는 깨어날 때
+  }
+  intr_set_level(old_level);
 }
 
-/* Sleep for approximately NUM/DENOM seconds. */
+/* Sleep for approximately NUM/DENOM seconds.  Whole ticks go
+   through timer_sleep(); shorter waits block on a one-shot PIT
+   interrupt in hr_sleep(), and only waits too short to be worth a
+   context switch spin on the TSC. */
 static void real_time_sleep(int64_t num, int32_t denom) {
   /* Convert NUM/DENOM seconds into timer ticks, rounding down.
 
@@ -203,18 +403,192 @@ static void real_time_sleep(int64_t num, int32_t denom) {
        timer_sleep() because it will yield the CPU to other
        processes. */
     timer_sleep(ticks);
+    return;
+  }
+
+  /* Otherwise convert to nanoseconds.  We scale the numerator and
+     denominator down by 1000 to avoid the possibility of
+     overflow. */
+  ASSERT(denom % 1000 == 0);
+  int64_t ns = num * 1000000 / (denom / 1000);
+  uint64_t deadline = timer_now_ns() + ns;
+
+  if (ns < TIMER_SPIN_NS) {
+    while (timer_now_ns() < deadline) asm volatile("pause");
+  } else
+    hr_sleep(deadline);
+}
+
+/* Blocks the current thread until timer_now_ns() reaches
+   DEADLINE, which is less than a tick away.  If DEADLINE falls
+   well before the next tick boundary, the PIT interrupts right at
+   it (hr_arm()); otherwise the next tick wakes us and we go around
+   again. */
+static void hr_sleep(uint64_t deadline) {
+  uint64_t now;
+
+  while ((now = timer_now_ns()) < deadline) {
+    enum intr_level old_level = intr_disable();
+    hr_arm(ns_to_pit(deadline - now));
+    list_push_back(&hr_waiters, &thread_current()->elem);
+    thread_block();
+    intr_set_level(old_level);
+  }
+}
+
+/* Makes the timer interrupt fire COUNT PIT input clocks from now,
+   if that is before the next tick boundary.  The boundary itself
+   is kept: after the one-shot, the PIT counts out the rest of the
+   tick in NOHZ_RESYNC.  Interrupts must be off. */
+static void hr_arm(uint32_t count) {
+  ASSERT(intr_get_level() == INTR_OFF);
+
+  if (nohz_state == NOHZ_OFF) {
+    uint32_t left = pit_read_count();  // 다음 tick 경계까지 남은 count
+    if (count + PIT_TICK_COUNT / 16 >= left) return;  // 곧 tick이 깨워준다
+    pit_set_oneshot(count);
+    hr_left = left - count;
+    nohz_state = NOHZ_HR;
+  } else if (nohz_state == NOHZ_HR) {
+    uint32_t pending = pit_read_count();  // 이미 걸린 one-shot까지 남은 count
+    if (count + PIT_TICK_COUNT / 16 >= pending) return;
+    pit_set_oneshot(count);
+    hr_left += pending - count;
+  }
+  /* NOHZ_RESYNC는 경계 직전이므로 다음 tick에 맡긴다 */
+}
+
+/* Wakes every thread in hr_sleep() so it can check its deadline.
+   Interrupts must be off. */
+static void hr_wake(void) {
+  while (!list_empty(&hr_waiters))
+    thread_unblock(list_entry(list_pop_front(&hr_waiters), struct thread, elem));
+}
+
+/* Converts NS nanoseconds to PIT input clocks, rounding up. */
+static uint32_t ns_to_pit(uint64_t ns) {
+  uint64_t count = (ns * PIT_HZ + 999999999) / 1000000000;
+  if (count == 0) count = 1;
+  return count > 0xffff ? 0xffff : (uint32_t)count;
+}
+
+/* Reads the time-stamp counter. */
+static inline uint64_t rdtsc(void) {
+  uint32_t lo, hi;
+  asm volatile("rdtsc" : "=a"(lo), "=d"(hi));
+  return (uint64_t)hi << 32 | lo;
+}
+
+/* Puts pending timer T into the wheel slot matching its distance
+   from wheel_tick.  Interrupts must be off. */
+static void wheel_insert(struct timer *t) {
+  int64_t expires = t->expires;
+  int64_t delta = expires - wheel_tick;
+  struct list *slot;
+
+  if (delta < 0) {
+    /* 이미 지난 시간이면 다음 tick에 처리되도록 */
+    slot = &tw0[wheel_tick & TW0_MASK];
+  } else if (delta < TW0_SIZE) {
+    slot = &tw0[expires & TW0_MASK];
   } else {
-    /* Otherwise, use a busy-wait loop for more accurate
-       sub-tick timing.  We scale the numerator and denominator
-       down by 1000 to avoid the possibility of overflow. */
-    ASSERT(denom % 1000 == 0);
-    busy_wait(loops_per_tick * num / 1000 * TIMER_FREQ / (denom / 1000));
+    /* 너무 먼 미래라면 wheel이 표현할 수 있는 최대 거리로 자름.
+       나중에 cascade 될 때 원래 expires로 다시 배치된다. */
+    if (delta > TW_MAX_DELTA) expires = wheel_tick + TW_MAX_DELTA;
+
+    int level = 0;
+    while (delta >= 1LL << (TW0_BITS + (level + 1) * TWN_BITS) && level < TWN_LEVELS - 1) level++;
+    slot = &twn[level][(expires >> (TW0_BITS + level * TWN_BITS)) & TWN_MASK];
+  }
+  list_push_back(slot, &t->elem);
+}
+
+/* Moves every timer in the current slot of higher LEVEL down to
+   the levels below it.  Returns the index of that slot, so the
+   caller can continue to the next level when it wraps to 0. */
+static int wheel_cascade(int level) {
+  int index = (wheel_tick >> (TW0_BITS + level * TWN_BITS)) & TWN_MASK;
+  struct list *slot = &twn[level][index];
+
+  while (!list_empty(slot)) {
+    struct timer *t = list_entry(list_pop_front(slot), struct timer, elem);
+    wheel_insert(t);
   }
+  return index;
 }
 
-static bool wake_tick_less(const struct list_elem *a, const struct list_elem *b, void *aux) {
-  struct thread *thread_a = list_entry(a, struct thread, sleep_elem);
-  struct thread *thread_b = list_entry(b, struct thread, sleep_elem);
+/* Processes every tick from wheel_tick up to and including the
+   current tick, running the callbacks of all timers that expired.
+   Each level-0 slot is detached as a batch first, so callbacks may
+   safely re-arm timers.  Called from the timer's bottom half; the
+   wheel is only touched with interrupts off, but the callbacks run
+   with interrupts on. */
+static void wheel_run(void) {
+  enum intr_level old_level = intr_disable();
+
+  while (wheel_tick <= ticks) {
+    int index = wheel_tick & TW0_MASK;
+    struct list expired;
+
+    /* level 0이 한 바퀴 돌았으면 상위 level의 slot을 내려보냄 */
+    if (index == 0)
+      for (int level = 0; level < TWN_LEVELS && wheel_cascade(level) == 0; level++) continue;
+
+    list_init(&expired);
+    while (!list_empty(&tw0[index])) list_push_back(&expired, list_pop_front(&tw0[index]));
+    wheel_tick++;
+
+    while (!list_empty(&expired)) {
+      struct timer *t = list_entry(list_pop_front(&expired), struct timer, elem);
+      t->pending = false;
+      intr_set_level(old_level);
+      t->func(t->aux);
+      intr_disable();
+    }
+  }
+  intr_set_level(old_level);
+}
+
+/* Returns the first tick before HORIZON at which the wheel has
+   work to do, or HORIZON if there is none.  A level-0 wrap counts
+   as work because it cascades timers from the upper levels, which
+   may then be due within the scanned range. */
+static int64_t wheel_next_event(int64_t horizon) {
+  for (int64_t t = wheel_tick; t < horizon; t++)
+    if ((t & TW0_MASK) == 0 || !list_empty(&tw0[t & TW0_MASK])) return t;
+  return horizon;
+}
+
+/* Programs PIT counter 0 for the periodic TIMER_FREQ tick. */
+static void pit_set_periodic(void) {
+  outb(0x43, 0x34); /* CW: counter 0, LSB then MSB, mode 2, binary. */
+  outb(0x40, PIT_TICK_COUNT & 0xff);
+  outb(0x40, PIT_TICK_COUNT >> 8);
+}
+
+/* Programs PIT counter 0 to interrupt once, COUNT input clocks
+   from now. */
+static void pit_set_oneshot(uint32_t count) {
+  ASSERT(count > 0 && count <= 0xffff);
+  outb(0x43, 0x30); /* CW: counter 0, LSB then MSB, mode 0, binary. */
+  outb(0x40, count & 0xff);
+  outb(0x40, count >> 8);
+}
+
+/* Returns the current value of PIT counter 0. */
+static uint32_t pit_read_count(void) {
+  outb(0x43, 0x00); /* Counter latch command for counter 0. */
+  uint8_t lo = inb(0x40);
+  uint8_t hi = inb(0x40);
+  return (uint32_t)hi << 8 | lo;
+}
+
+/* Returns true if counter 0's OUT pin is high, which in mode 0
+   means the one-shot count has run out. */
+static bool pit_output_high(void) {
+  outb(0x43, 0xe2); /* Read-back: status only, counter 0. */
+  return (inb(0x40) & 0x80) != 0;
+}
 
-  return thread_a->wake_tick < thread_b->wake_tick;
-}
\ No newline at end of file
+/* Timer callback used by timer_sleep(): unblocks THREAD_. */
+static void timer_wakeup(void *thread_) { thread_unblock(thread_); }
\ No newline at end of file
@@ -23,7 +23,7 @@
 /* A circular queue of bytes. */
 struct intq {
 	/* Waiting threads. */
-	struct lock lock;           /* Only one thread may wait at once. */
+	struct semaphore wait_sema; /* Only one thread may wait at once. */
 	struct thread *not_full;    /* Thread waiting for not-full condition. */
 	struct thread *not_empty;   /* Thread waiting for not-empty condition. */
 
@@ -37,6 +37,7 @@ void intq_init (struct intq *);
 bool intq_empty (const struct intq *);
 bool intq_full (const struct intq *);
 uint8_t intq_getc (struct intq *);
+bool intq_getc_interruptible (struct intq *, uint8_t *);
 void intq_putc (struct intq *, uint8_t);
 
 #endif /* devices/intq.h */
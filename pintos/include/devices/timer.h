@@ -1,12 +1,30 @@
 #ifndef DEVICES_TIMER_H
 #define DEVICES_TIMER_H
 
+#include <list.h>
 #include <round.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /* Number of timer interrupts per second. */
 #define TIMER_FREQ 100
 
+/* One-shot kernel timer.  FUNC(AUX) is called from the timer
+   interrupt's bottom half (see threads/workqueue.h), in interrupt
+   context but with interrupts on, once timer_ticks() reaches
+   EXPIRES.  The owner provides the storage. */
+typedef void timer_func (void *aux);
+struct timer {
+	int64_t expires;            /* Tick at which FUNC runs. */
+	timer_func *func;           /* Callback. */
+	void *aux;                  /* Callback argument. */
+	bool pending;               /* On the timer wheel? */
+	struct list_elem elem;      /* Timer wheel slot list element. */
+};
+
+/* Dynamic tick mode ("-nohz"). */
+extern bool timer_nohz;
+
 void timer_init (void);
 void timer_calibrate (void);
 
@@ -18,6 +36,17 @@ void timer_msleep (int64_t milliseconds);
 void timer_usleep (int64_t microseconds);
 void timer_nsleep (int64_t nanoseconds);
 
+uint64_t timer_now_ns (void);
+uint64_t timer_cycles (void);
+uint64_t timer_cycles_hz (void);
+
+void timer_setup (struct timer *, timer_func *, void *aux);
+void timer_add (struct timer *, int64_t expires);
+bool timer_cancel (struct timer *);
+
+void timer_idle_enter (void);
+void timer_idle_exit (void);
+
 void timer_print_stats (void);
 
 #endif /* devices/timer.h */
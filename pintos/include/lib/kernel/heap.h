@@ -0,0 +1,69 @@
+#ifndef __LIB_KERNEL_HEAP_H
+#define __LIB_KERNEL_HEAP_H
+
+/* Priority queue (pairing heap).
+ *
+ * Like list.h, this heap does not allocate: each structure that
+ * may be put in a heap embeds a struct heap_elem, and heap_entry
+ * converts a heap_elem back to the structure containing it.  The
+ * ordering is given by a heap_less_func; heap_top() returns the
+ * greatest element, and among equal elements the one that was
+ * pushed first.
+ *
+ * heap_push() and heap_top() are O(1).  heap_pop(),
+ * heap_remove() and heap_update() are O(log n) amortized.  The
+ * key of an element must not change while it is in a heap except
+ * through heap_update() or heap_apply(). */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Heap element. */
+struct heap_elem {
+	struct heap_elem *child;    /* Leftmost child. */
+	struct heap_elem *next;     /* Next sibling. */
+	struct heap_elem *prev;     /* Previous sibling, or parent if first child. */
+	uint64_t seq;               /* Push order, breaks ties. */
+};
+
+/* Compares the value of two heap elements A and B, given
+   auxiliary data AUX.  Returns true if A is less than B, or
+   false if A is greater than or equal to B. */
+typedef bool heap_less_func (const struct heap_elem *a,
+                             const struct heap_elem *b,
+                             void *aux);
+
+/* Heap. */
+struct heap {
+	struct heap_elem *root;     /* Greatest element, or null. */
+	size_t size;                /* Number of elements. */
+	uint64_t next_seq;          /* Stamp for the next push. */
+	heap_less_func *less;       /* Ordering. */
+	void *aux;                  /* Auxiliary data for LESS. */
+};
+
+/* Converts pointer to heap element HEAP_ELEM into a pointer to
+   the structure that HEAP_ELEM is embedded inside.  Supply the
+   name of the outer structure STRUCT and the member name MEMBER
+   of the heap element. */
+#define heap_entry(HEAP_ELEM, STRUCT, MEMBER)           \
+	((STRUCT *) ((uint8_t *) &(HEAP_ELEM)->child    \
+		- offsetof (STRUCT, MEMBER.child)))
+
+void heap_init (struct heap *, heap_less_func *, void *aux);
+bool heap_empty (const struct heap *);
+size_t heap_size (const struct heap *);
+
+void heap_push (struct heap *, struct heap_elem *);
+struct heap_elem *heap_top (const struct heap *);
+struct heap_elem *heap_pop (struct heap *);
+void heap_remove (struct heap *, struct heap_elem *);
+void heap_update (struct heap *, struct heap_elem *);
+
+/* Calls ACTION on every element, which may change its key, then
+   restores heap order.  O(n). */
+typedef void heap_action_func (struct heap_elem *, void *aux);
+void heap_apply (struct heap *, heap_action_func *, void *aux);
+
+#endif /* lib/kernel/heap.h */
@@ -0,0 +1,63 @@
+#ifndef __LIB_KERNEL_RBTREE_H
+#define __LIB_KERNEL_RBTREE_H
+
+/* Ordered set (red-black tree).
+ *
+ * Like list.h and heap.h, this tree does not allocate: each
+ * structure that may be put in a tree embeds a struct rb_elem,
+ * and rb_entry converts an rb_elem back to the structure
+ * containing it.  The ordering is given by an rb_less_func.
+ * Equal elements are allowed; a new element goes after the ones
+ * already equal to it, so they come out in insertion order.
+ *
+ * rb_insert() and rb_remove() are O(log n).  rb_min() is O(1),
+ * the leftmost element being cached.  The key of an element must
+ * not change while it is in a tree: remove it, change the key and
+ * insert it again. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Tree element. */
+struct rb_elem {
+	struct rb_elem *parent;     /* Parent, or null for the root. */
+	struct rb_elem *left;       /* Lesser subtree. */
+	struct rb_elem *right;      /* Greater or equal subtree. */
+	bool red;                   /* Node color. */
+};
+
+/* Compares the value of two tree elements A and B, given
+   auxiliary data AUX.  Returns true if A is less than B, or
+   false if A is greater than or equal to B. */
+typedef bool rb_less_func (const struct rb_elem *a,
+                           const struct rb_elem *b,
+                           void *aux);
+
+/* Red-black tree. */
+struct rb_tree {
+	struct rb_elem *root;       /* Root, or null. */
+	struct rb_elem *min;        /* Leftmost element, or null. */
+	size_t size;                /* Number of elements. */
+	rb_less_func *less;         /* Ordering. */
+	void *aux;                  /* Auxiliary data for LESS. */
+};
+
+/* Converts pointer to tree element RB_ELEM into a pointer to the
+   structure that RB_ELEM is embedded inside.  Supply the name of
+   the outer structure STRUCT and the member name MEMBER of the
+   tree element. */
+#define rb_entry(RB_ELEM, STRUCT, MEMBER)               \
+	((STRUCT *) ((uint8_t *) &(RB_ELEM)->parent     \
+		- offsetof (STRUCT, MEMBER.parent)))
+
+void rb_init (struct rb_tree *, rb_less_func *, void *aux);
+bool rb_empty (const struct rb_tree *);
+size_t rb_size (const struct rb_tree *);
+
+void rb_insert (struct rb_tree *, struct rb_elem *);
+void rb_remove (struct rb_tree *, struct rb_elem *);
+struct rb_elem *rb_min (const struct rb_tree *);
+struct rb_elem *rb_next (const struct rb_elem *);
+
+#endif /* lib/kernel/rbtree.h */
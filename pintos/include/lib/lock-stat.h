@@ -0,0 +1,45 @@
+#ifndef __LIB_LOCK_STAT_H
+#define __LIB_LOCK_STAT_H
+
+#include <stdint.h>
+
+/* Lock contention statistics, shared by the kernel
+   (threads/lockstat.c) and user programs through the lockstat()
+   system call.
+
+   Statistics are kept per lock class: all the locks (or
+   semaphores) initialized by the same line of code share one
+   record, so e.g. the pos_lock of every open file adds up in a
+   single line.  A lock given a name with lock_set_name() gets a
+   record of its own, keyed by its address as well as its site,
+   so that singletons such as filesys_lock or frame_lock are
+   reported per instance.  Times are in nanoseconds, from the
+   TSC. */
+
+enum lock_stat_kind {
+	LOCK_STAT_LOCK,             /* struct lock, or the lock in an rwlock. */
+	LOCK_STAT_SEMA,             /* struct semaphore. */
+};
+
+#define LOCK_STAT_NAME_LEN 23
+
+struct lock_stat {
+	char name[LOCK_STAT_NAME_LEN + 1]; /* Given name, or "" if none. */
+	uint64_t site;              /* Address of the code that initialized it. */
+	uint64_t instance;          /* Address of the named lock, or 0 for
+	                               the unnamed locks of a class. */
+	uint64_t instances;         /* # of objects initialized there. */
+	uint64_t acquired;          /* # of acquisitions (downs). */
+	uint64_t contended;         /* # of acquisitions that had to wait. */
+	uint64_t wait_ns;           /* Total time spent waiting, including,
+	                               for an rwlock, writers waiting for
+	                               readers to leave. */
+	uint64_t wait_max_ns;       /* Longest single wait. */
+	uint64_t hold_ns;           /* Total time held (locks only). */
+	uint64_t hold_max_ns;       /* Longest single hold (locks only). */
+	uint32_t max_depth;         /* Longest priority donation chain a
+	                               waiter started, in threads. */
+	uint32_t kind;              /* enum lock_stat_kind. */
+};
+
+#endif /* lib/lock-stat.h */
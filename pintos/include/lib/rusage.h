@@ -0,0 +1,33 @@
+#ifndef __LIB_RUSAGE_H
+#define __LIB_RUSAGE_H
+
+#include <stdint.h>
+
+/* Resource usage, shared by the kernel and user programs through
+   the getrusage() system call.
+
+   User and system time are measured with the TSC on every switch
+   between user and kernel mode and on every context switch, so
+   they are exact to within the cost of reading the clock, not
+   rounded to timer ticks.  Times are in nanoseconds. */
+
+enum rusage_who {
+	RUSAGE_SELF,                /* All threads of the calling process. */
+	RUSAGE_CHILDREN,            /* Children that have been waited for,
+	                               and their own waited-for children. */
+	RUSAGE_THREAD,              /* The calling thread only. */
+};
+
+struct rusage {
+	uint64_t utime_ns;          /* Time spent in user mode. */
+	uint64_t stime_ns;          /* Time spent in the kernel on our behalf. */
+	uint64_t nvcsw;             /* Context switches because we blocked. */
+	uint64_t nivcsw;            /* Context switches because we were preempted. */
+	uint64_t minflt;            /* Page faults served without disk I/O. */
+	uint64_t majflt;            /* Page faults that had to read the disk. */
+	uint64_t nswapin;           /* Pages read back from swap. */
+	uint64_t inblock;           /* Disk sectors read. */
+	uint64_t oublock;           /* Disk sectors written. */
+};
+
+#endif /* lib/rusage.h */
@@ -0,0 +1,53 @@
+#ifndef __LIB_SCHED_TRACE_H
+#define __LIB_SCHED_TRACE_H
+
+#include <stdint.h>
+
+/* Scheduler trace records, shared by the kernel (threads/trace.c)
+   and user programs through the sched_trace() system call. */
+
+/* Event types.  TID is the thread the event is about; the meaning
+   of ARG and DATA depends on the type. */
+enum sched_event_type {
+	SCHED_EV_SWITCH_OUT,        /* TID stops running.  ARG: its new status. */
+	SCHED_EV_SWITCH_IN,         /* TID starts running.  ARG: its priority. */
+	SCHED_EV_WAKEUP,            /* TID made ready.  ARG: waker's tid;
+	                               DATA: 1 if woken from an interrupt. */
+	SCHED_EV_BLOCK,             /* TID blocks.  ARG: enum sched_block_reason;
+	                               DATA: caller of thread_block(). */
+	SCHED_EV_PRIORITY,          /* TID's effective priority changed by a
+	                               donation.  ARG: new; DATA: old. */
+	SCHED_EV_LOCK_HANDOFF,      /* Lock handed to waiting TID.  ARG: tid of
+	                               the releaser; DATA: lock address. */
+	SCHED_EV_CNT
+};
+
+/* What a thread blocked on. */
+enum sched_block_reason {
+	SCHED_BLOCK_OTHER,          /* Direct thread_block(), e.g. timer sleep. */
+	SCHED_BLOCK_SEMA,           /* sema_down(). */
+	SCHED_BLOCK_LOCK,           /* lock_acquire(). */
+	SCHED_BLOCK_COND,           /* cond_wait(). */
+	SCHED_BLOCK_RWLOCK,         /* Writer waiting for readers to drain. */
+};
+
+struct sched_event {
+	uint64_t ts;                /* Nanoseconds since boot, from the TSC. */
+	uint64_t data;              /* Type-specific. */
+	int32_t tid;                /* Subject thread. */
+	int32_t arg;                /* Type-specific. */
+	uint16_t type;              /* enum sched_event_type. */
+	uint16_t cpu;               /* CPU that recorded the event. */
+};
+
+/* Log2 histograms.  Bucket B counts samples of [2^B, 2^(B+1))
+   nanoseconds; bucket 0 also counts 0 and the last bucket
+   everything above. */
+#define SCHED_HIST_BUCKETS 40
+
+struct sched_hist {
+	uint64_t wakeup_latency[SCHED_HIST_BUCKETS]; /* Wakeup to running. */
+	uint64_t slice[SCHED_HIST_BUCKETS];          /* Run time per switch-in. */
+};
+
+#endif /* lib/sched-trace.h */
@@ -36,6 +36,19 @@ enum {
 
 	SYS_MOUNT,
 	SYS_UMOUNT,
+
+	/* Diagnostics. */
+	SYS_SCHED_TRACE,            /* Read scheduler trace and histograms. */
+	SYS_LOCKSTAT,               /* Read lock contention statistics. */
+
+	/* User threads. */
+	SYS_THREAD_CREATE,          /* Start a thread in this process. */
+	SYS_THREAD_EXIT,            /* Exit the calling thread. */
+	SYS_FUTEX_WAIT,             /* Sleep while a user word holds a value. */
+	SYS_FUTEX_WAKE,             /* Wake threads sleeping on a user word. */
+
+	/* Accounting. */
+	SYS_GETRUSAGE,              /* Read resource usage. */
 };
 
 #endif /* lib/syscall-nr.h */
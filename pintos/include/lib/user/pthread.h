@@ -0,0 +1,42 @@
+#ifndef __LIB_USER_PTHREAD_H
+#define __LIB_USER_PTHREAD_H
+
+#include <debug.h>
+
+/* A small subset of POSIX threads on top of the thread_create,
+   thread_exit, futex_wait and futex_wake system calls.  Thread
+   stacks come from a fixed pool, so at most PTHREAD_MAX threads
+   (besides the initial one) may exist at once. */
+
+#define PTHREAD_MAX 16                  /* Threads alive at once. */
+#define PTHREAD_STACK_SIZE (16 * 1024)  /* Bytes of stack per thread. */
+
+typedef struct pthread *pthread_t;
+
+int pthread_create (pthread_t *, void *(*start) (void *), void *arg);
+int pthread_join (pthread_t, void **retval);
+void pthread_exit (void *retval) NO_RETURN;
+
+/* Mutex: 0 = unlocked, 1 = locked, 2 = locked with waiters. */
+typedef struct {
+	int state;
+} pthread_mutex_t;
+#define PTHREAD_MUTEX_INITIALIZER { 0 }
+
+int pthread_mutex_init (pthread_mutex_t *);
+int pthread_mutex_lock (pthread_mutex_t *);
+int pthread_mutex_trylock (pthread_mutex_t *);
+int pthread_mutex_unlock (pthread_mutex_t *);
+
+/* Condition variable: a sequence number bumped by every signal. */
+typedef struct {
+	int seq;
+} pthread_cond_t;
+#define PTHREAD_COND_INITIALIZER { 0 }
+
+int pthread_cond_init (pthread_cond_t *);
+int pthread_cond_wait (pthread_cond_t *, pthread_mutex_t *);
+int pthread_cond_signal (pthread_cond_t *);
+int pthread_cond_broadcast (pthread_cond_t *);
+
+#endif /* lib/user/pthread.h */
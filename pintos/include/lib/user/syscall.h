@@ -4,6 +4,9 @@
 #include <stdbool.h>
 #include <debug.h>
 #include <stddef.h>
+#include <lock-stat.h>
+#include <rusage.h>
+#include <sched-trace.h>
 
 /* Process identifier. */
 typedef int pid_t;
@@ -50,6 +53,19 @@ bool isdir (int fd);
 int inumber (int fd);
 int symlink (const char* target, const char* linkpath);
 
+/* Diagnostics. */
+int sched_trace (struct sched_event *events, int max, struct sched_hist *hist);
+int lockstat (struct lock_stat *stats, int max);
+
+/* User threads. */
+int thread_create (void (*entry) (void *), void *arg, void *stack, int *tidp);
+void thread_exit (void) NO_RETURN;
+int futex_wait (int *addr, int val);
+int futex_wake (int *addr, int cnt);
+
+/* Accounting. */
+int getrusage (int who, struct rusage *usage);
+
 static inline void* get_phys_addr (void *user_addr) {
 	void* pa;
 	asm volatile ("movq %0, %%rax" ::"r"(user_addr));
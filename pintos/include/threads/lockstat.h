@@ -0,0 +1,32 @@
+#ifndef THREADS_LOCKSTAT_H
+#define THREADS_LOCKSTAT_H
+
+#include <lock-stat.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Lock contention statistics ("-lockstat").
+ *
+ * When enabled, lock_init() and sema_init() attach each lock and
+ * semaphore to the struct lock_stat of its initialization site,
+ * and threads/synch.c reports every acquisition, wait, hold and
+ * donation chain to it.  When disabled, locks carry a null
+ * record and the hooks cost a single test.  The table is printed
+ * at power off and can be read by user programs with the
+ * lockstat() system call. */
+#define LOCKSTAT_MAX 256
+
+extern bool lockstat_enabled;
+
+struct lock_stat *lockstat_register (enum lock_stat_kind, const void *site);
+struct lock_stat *lockstat_set_name (struct lock_stat *, const void *instance,
+                                     const char *name);
+void lockstat_acquired (struct lock_stat *, bool contended, uint64_t wait_ns);
+void lockstat_waited (struct lock_stat *, uint64_t wait_ns);
+void lockstat_released (struct lock_stat *, uint64_t hold_ns);
+void lockstat_depth (struct lock_stat *, int depth);
+
+int lockstat_snapshot (struct lock_stat *, int max);
+void lockstat_print_stats (void);
+
+#endif /* threads/lockstat.h */
@@ -0,0 +1,26 @@
+#ifndef THREADS_PROFILE_H
+#define THREADS_PROFILE_H
+
+#include <stdbool.h>
+
+#include "threads/interrupt.h"
+
+/* Statistical sampling profiler ("-profile").
+ *
+ * On every timer tick, profile_sample() walks the frame-pointer
+ * chain of whatever the tick interrupted, kernel or user code, and
+ * counts the call stack in the running CPU's table of distinct
+ * stacks.  At power off the tables are printed in folded form, one
+ * "PROF <root>;...;<leaf> <count>" line per stack, which
+ * `backtrace -f' turns into symbolized input for a flame graph.
+ * Stacks deeper than PROFILE_DEPTH frames are cut at the root
+ * end. */
+#define PROFILE_DEPTH 16
+
+extern bool profile_enabled;
+
+void profile_init (int cpu_cnt);
+void profile_sample (const struct intr_frame *);
+void profile_print_stats (void);
+
+#endif /* threads/profile.h */
@@ -0,0 +1,32 @@
+#ifndef THREADS_SWITCH_H
+#define THREADS_SWITCH_H
+
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+
+/* Stack frame saved by switch_threads().
+ *
+ * Only the callee-saved registers of the System V AMD64 ABI are
+ * kept: everything else is already dead across the call, and
+ * segment registers and rflags are the same for every kernel
+ * thread.  The lowest address comes first. */
+struct switch_threads_frame {
+	uint64_t r15;
+	uint64_t r14;
+	uint64_t r13;
+	uint64_t r12;
+	uint64_t rbx;               /* switch_entry(): intr_frame to launch. */
+	uint64_t rbp;
+	void (*rip) (void);         /* Return address. */
+};
+
+/* Saves the current stack pointer in *PREV_SP and resumes the
+ * thread whose stack pointer is NEXT_SP.  Returns when some other
+ * thread switches back to us. */
+void switch_threads (uint64_t *prev_sp, uint64_t next_sp);
+
+/* First-launch trampoline for a new thread; see switch.S. */
+void switch_entry (void);
+#endif
+
+#endif /* threads/switch.h */
@@ -1,37 +1,88 @@
 #ifndef THREADS_SYNCH_H
 #define THREADS_SYNCH_H
 
+#include <heap.h>
 #include <list.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+struct lock_stat;
 
 /* A counting semaphore. */
 struct semaphore {
 	unsigned value;             /* Current value. */
-	struct list waiters;        /* List of waiting threads. */
+	struct heap waiters;        /* Waiting threads, highest priority on top. */
+	struct lock_stat *stat;     /* Contention statistics, or NULL. */
 };
 
 void sema_init (struct semaphore *, unsigned value);
 void sema_down (struct semaphore *);
+bool sema_down_interruptible (struct semaphore *);
 bool sema_try_down (struct semaphore *);
 void sema_up (struct semaphore *);
 void sema_self_test (void);
 
+/* Priority donation carried by something a thread holds: the
+   highest priority among the threads waiting for it.  Kept in the
+   holder's held_locks heap, so the best donation is its top. */
+struct donation {
+	struct heap_elem elem;      /* holder의 held_locks 힙의 노드 */
+	int priority;               /* 기부되는 priority (없으면 -1) */
+};
+
 /* Lock. */
 struct lock {
 	struct thread *holder;      /* Thread holding lock (for debugging). */
 	struct semaphore semaphore; /* Binary semaphore controlling access. */
-	struct list_elem holder_elem; /* thread의 acquired_locks의 노드 */
+	struct donation donation;   /* 대기자들이 holder에게 주는 기부 */
+	struct lock_stat *stat;     /* Contention statistics, or NULL. */
+	uint64_t stat_taken;        /* When HOLDER took it, if STAT. */
 };
 
 void lock_init (struct lock *);
+void lock_set_name (struct lock *, const char *name);
 void lock_acquire (struct lock *);
 bool lock_try_acquire (struct lock *);
 void lock_release (struct lock *);
 bool lock_held_by_current_thread (const struct lock *);
+bool donation_less (const struct heap_elem *, const struct heap_elem *,
+                    void *aux);
+void lock_refresh_priority (struct thread *);
+
+/* Readers-writer lock.  Any number of readers or a single writer
+   may hold it.  A writer that arrives waits for the current
+   readers to leave while new readers queue up behind it, and it
+   donates its priority to those readers meanwhile.  Waiters for
+   the writer donate to it as with a lock. */
+struct rwlock {
+	struct lock lock;           /* Held by the writer; readers pass through. */
+	unsigned readers;           /* Number of readers holding the lock. */
+	struct list reader_holds;   /* struct rwlock_hold of each reader. */
+	struct semaphore drain;     /* Writer waits here for the readers. */
+	struct thread *writer;      /* Writer waiting on DRAIN, or NULL. */
+};
+
+/* One thread's read hold on an rwlock.  Each thread has
+   RWLOCK_HOLD_MAX of these, so that is how many rwlocks it may
+   hold for reading at once. */
+#define RWLOCK_HOLD_MAX 2
+struct rwlock_hold {
+	struct rwlock *rwlock;      /* Lock held for reading, or NULL if free. */
+	struct thread *thread;      /* Reader. */
+	struct list_elem elem;      /* rwlock의 reader_holds 노드 */
+	struct donation donation;   /* 대기 중인 writer가 reader에게 주는 기부 */
+};
+
+void rwlock_init (struct rwlock *);
+void rwlock_set_name (struct rwlock *, const char *name);
+void rwlock_read_acquire (struct rwlock *);
+void rwlock_read_release (struct rwlock *);
+void rwlock_write_acquire (struct rwlock *);
+void rwlock_write_release (struct rwlock *);
 
 /* Condition variable. */
 struct condition {
-	struct list waiters;        /* List of waiting threads. */
+	struct heap waiters;        /* Waiters, highest priority on top. */
 };
 
 void cond_init (struct condition *);
@@ -3,8 +3,11 @@
 
 #include <debug.h>
 #include <list.h>
+#include <rbtree.h>
+#include <rusage.h>
 #include <stdint.h>
 
+#include "devices/timer.h"
 #include "threads/fixed-point.h"
 #include "threads/interrupt.h"
 #include "threads/synch.h"
@@ -31,6 +34,11 @@ typedef int tid_t;
 #define PRI_DEFAULT 31 /* Default priority. */
 #define PRI_MAX 63     /* Highest priority. */
 
+/* Upper bound on CPU ids, for tables indexed by thread_cpu_id().
+   Only the bootstrap processor is started, so only id 0 is used
+   for now. */
+#define CPU_MAX 16
+
 /* 자식 상태 */
 struct child_status {
   tid_t tid;
@@ -43,6 +51,7 @@ struct child_status {
   struct semaphore load_sema;  // load 완료 표시 부모에게
   bool load_done;              // load 한번만
   bool load_ok;                // load완료 확인
+  struct rusage ru;            // 종료 시 자원 사용량 (자기 + 거둔 자식들)
   struct list_elem elem;  // parent->children 에 매달림, 부모의 children list 용
 };
 
@@ -97,44 +106,68 @@ struct child_status {
  * the `magic' member of the running thread's `struct thread' is
  * set to THREAD_MAGIC.  Stack overflow will normally ge this
  * value, triggering the assertion. */
-/* The `elem' member has a dual purpose.  It can be an element in
- * the run queue (thread.c), or it can be an element in a
- * semaphore wait list (synch.c).  It can be used these two ways
- * only because they are mutually exclusive: only a thread in the
- * ready state is on the run queue, whereas only a thread in the
- * blocked state is on a semaphore wait list. */
+/* The `elem' member is an element in the run queue (thread.c).
+ * A thread blocked on a semaphore is instead kept in the
+ * semaphore's priority heap through `wait_elem' (synch.c), so
+ * that it can be re-keyed in place when it receives a donation. */
 struct thread {
   /* Owned by thread.c. */
   tid_t tid; /* Thread identifier. */
 
-  struct list children;            // struct child_status 노드들의 리스트
+  struct list children;            // 리더: 프로세스가 만든 struct child_status 노드들의 리스트
   struct child_status *my_status;  // 내가 종료시 업데이트할 내 노드
 
   enum thread_status status; /* Thread state. */
   char name[16];             /* Name (for debugging purposes). */
   int priority;              /* Priority. */
+  int queued_priority;       /* run queue에 들어갈 당시의 priority */
+  int adapt_score;           /* -adaptive: +면 I/O 위주, -면 CPU 위주 */
 
   /* Shared between thread.c and synch.c. */
   struct list_elem elem;       /* List element. */
-  int64_t wake_tick;           /* 쓰레드를 깨울 시간 */
-  struct list_elem sleep_elem; /* sleep_list에서의 연결리스트 노드 */
   struct list_elem all_elem;   /* all_list에서의 연결리스트 노드 */
 
+  struct heap_elem wait_elem;    /* semaphore 대기 힙의 노드 */
+  struct heap *wait_heap;        /* wait_elem이 들어있는 힙 (없으면 NULL) */
+  struct semaphore_elem *cond_waiter; /* cond_wait 중일 때 cond 힙의 노드 */
+  bool interruptible;            /* thread_interrupt()가 깨울 수 있는 대기 중 */
+  bool interrupted;              /* thread_interrupt()를 받음 */
+
   int original_priority;         /* 원래 우선순위(기부 이전) */
-  struct list acquired_locks;    /* 현재 보유(점유) 중인 락들 */
+  struct heap held_locks;        /* 보유 중인 락들, 기부가 큰 순 (struct donation) */
   struct lock *waiting_for_lock; /* 내가 기다리고 있는 락 */
-  int is_donated;                /* 현재 우선순위가 기부받고 있는 상황인지 */
+  struct rwlock *waiting_for_readers;          /* reader가 빠지길 기다리는 rwlock */
+  struct rwlock_hold rw_holds[RWLOCK_HOLD_MAX]; /* read로 잡은 rwlock들 */
 
   /* mlfqs 전용*/
   int nice;           /* CPU를 양보하는 척도 (-20~20) */
   fixed_t recent_cpu; /* 최근 CPU 사용량 (fixed-point)*/
+  int64_t decay_epoch; /* recent_cpu에 마지막으로 감쇠를 반영한 epoch */
+
+  /* cfs 전용 */
+  uint64_t vruntime;       /* nice 가중치로 환산한 누적 실행 시간 (ns) */
+  uint64_t exec_start;     /* vruntime을 마지막으로 갱신한 시각 (ns) */
+  uint64_t slice_exec;     /* 이번에 CPU를 잡은 뒤 실행한 시간 (ns) */
+  struct rb_elem cfs_elem; /* cpu의 cfs_tree에서의 노드 */
+
+  /* edf 전용 (thread_set_deadline), 단위는 ns, dl_period가 0이면 일반 쓰레드 */
+  int64_t dl_period;       /* 주기 */
+  int64_t dl_runtime;      /* 주기마다 보장받는 실행 시간 */
+  int64_t dl_deadline;     /* 주기 시작부터 상대 deadline */
+  int64_t dl_abs_deadline; /* 현재 주기의 절대 deadline (timer_now_ns 기준) */
+  int64_t dl_budget;       /* 이번 주기에 남은 실행 시간 */
+  bool dl_throttled;       /* budget 소진, 다음 주기까지 실행 불가 */
+  struct rb_elem dl_elem;  /* cpu의 edf_tree에서의 노드 */
+  struct timer dl_timer;   /* 다음 주기에 budget을 채우는 타이머 */
+
+  /* 자원 사용량 (getrusage) */
+  struct rusage ru;  /* 이 쓰레드 몫 */
+  uint64_t ru_stamp; /* utime/stime을 마지막으로 반영한 시각 (ns) */
 
   int exit_status;  /* 상태 */
   bool proc_inited; /* init 한번만 하려고 */
 
   /* 시스템 콜 */
-  struct lock filesys_lock;
-
   struct file **fd_table;     // 파일 포인터 배열
   int fd_cap;                 // 한계
   bool fd_table_from_palloc;  // exec 누수 관리용
@@ -146,14 +179,31 @@ struct thread {
 #ifdef USERPROG
   /* Owned by userprog/process.c. */
   uint64_t *pml4; /* Page map level 4 */
+
+  /* 유저 쓰레드 (thread_create 시스템 콜). 한 프로세스의 쓰레드들은
+     리더(프로세스를 만든 쓰레드)의 pml4, spt, fd_table을 공유한다. */
+  struct thread *proc;             /* 프로세스 리더, 리더 자신은 자기를 가리킴 */
+  int nthreads;                    /* 리더: 살아 있는 워커 쓰레드 수 */
+  struct list proc_threads;        /* 리더: 살아 있는 워커 쓰레드 목록 */
+  struct list_elem proc_elem;      /* 워커: 리더의 proc_threads 노드 */
+  struct semaphore thread_exited;  /* 리더: 워커가 끝날 때마다 up */
+  bool exiting;                    /* 리더: 프로세스가 끝나는 중 */
+  int *clear_tid;                  /* 워커: 끝날 때 0을 쓰고 futex_wake할 주소 */
+  struct rusage ru_exited;         /* 리더: 끝난 워커들의 자원 사용량 */
+  struct rusage ru_children;       /* 리더: wait으로 거둔 자식 프로세스들의 몫 */
 #endif
 #ifdef VM
   /* Table for whole virtual memory owned by thread. */
   struct supplemental_page_table spt;
 #endif
 
+  /* Owned by threads/trace.c. */
+  uint64_t trace_in_ns;     /* When this thread last started running. */
+  uint64_t trace_wakeup_ns; /* When it was last made ready, or 0. */
+
   /* Owned by thread.c. */
-  struct intr_frame tf; /* Information for switching */
+  uint64_t stack;       /* Saved stack pointer (switch_threads). */
+  struct intr_frame tf; /* Information for first launch */
   unsigned magic;       /* Detects stack overflow. */
 };
 
@@ -162,20 +212,43 @@ struct thread {
    Controlled by kernel command-line option "-o mlfqs". */
 extern bool thread_mlfqs;
 
+/* If true, use the completely fair scheduler: run the ready
+   thread that has had the least CPU time, weighted by nice.
+   Controlled by kernel command-line option "-cfs". */
+extern bool thread_cfs;
+
+/* If true, put an unmapped guard page below every thread's page.
+   Controlled by kernel command-line option "-stack-guard". */
+extern bool thread_stack_guard;
+
+/* If true, the priority scheduler adapts time slices to each
+   thread's behavior: threads that keep blocking early are boosted,
+   threads that keep using up their slice get longer slices.
+   Controlled by kernel command-line option "-adaptive[=L,M,H]". */
+extern bool thread_adaptive;
+bool thread_set_adaptive(const char *quanta);
+
 void thread_init(void);
 void thread_start(void);
 
 void thread_tick(void);
 void thread_print_stats(void);
 
+void thread_ru_enter_kernel(void);
+void thread_ru_leave_kernel(void);
+void thread_get_rusage(struct thread *, struct rusage *);
+
 typedef void thread_func(void *aux);
 tid_t thread_create(const char *name, int priority, thread_func *, void *);
 
 void thread_block(void);
 void thread_unblock(struct thread *);
+bool thread_block_interruptible(void);
+void thread_interrupt(struct thread *);
 
 struct thread *thread_current(void);
 tid_t thread_tid(void);
+int thread_cpu_id(void);
 const char *thread_name(void);
 
 void thread_exit(void) NO_RETURN;
@@ -186,20 +259,18 @@ void thread_set_priority(int);
 
 int thread_get_nice(void);
 void thread_set_nice(int);
+bool thread_set_deadline(int64_t period, int64_t runtime, int64_t deadline);
 int thread_get_recent_cpu(void);
-void thread_update_all_recent_cpu(void);
 int thread_get_load_avg(void);
 void thread_update_load_avg(void);
 void do_iret(struct intr_frame *tf);
 
-struct list *get_ready_list(void);
-struct list *get_sleep_list(void);
-
-void thread_update_all_priority(void);
+void thread_mlfqs_decay(void);
+void thread_mlfqs_refresh(struct thread *t);
+int thread_mlfqs_last_visited(void);
 void mlfqs_update_priority(struct thread *t);
-bool thread_priority_less(const struct list_elem *, const struct list_elem *,
-                          void *);
 bool is_not_idle(struct thread *);
-int max_priority_mlfqs_queue(void);
+int thread_max_ready_priority(void);
+void thread_requeue(struct thread *t);
 
 #endif /* threads/thread.h */
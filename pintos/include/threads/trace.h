@@ -0,0 +1,31 @@
+#ifndef THREADS_TRACE_H
+#define THREADS_TRACE_H
+
+#include <sched-trace.h>
+
+struct thread;
+struct lock;
+
+/* Scheduler event tracing.
+ *
+ * Every CPU records scheduler events into its own ring of the
+ * last TRACE_RING_SIZE events, and folds wakeup-to-run latency
+ * and time-slice usage into log2 histograms.  Only the owning CPU
+ * writes its ring, with interrupts off, so recording takes no
+ * lock; readers detect and drop records overwritten under them.
+ * The histograms are printed at power off and both can be read
+ * by user programs with the sched_trace() system call. */
+#define TRACE_RING_SIZE 1024
+
+void trace_init (int cpu_cnt);
+void trace_switch (struct thread *prev, struct thread *next);
+void trace_wakeup (struct thread *);
+void trace_block (struct thread *, void *caller);
+void trace_priority (struct thread *, int old_priority);
+void trace_lock_handoff (struct lock *, struct thread *next_holder);
+
+int trace_snapshot (struct sched_event *, int max);
+void trace_hist (struct sched_hist *);
+void trace_print_stats (void);
+
+#endif /* threads/trace.h */
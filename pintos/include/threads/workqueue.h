@@ -0,0 +1,43 @@
+#ifndef THREADS_WORKQUEUE_H
+#define THREADS_WORKQUEUE_H
+
+#include <list.h>
+#include <stdbool.h>
+
+/* Deferred work.
+ *
+ * An interrupt handler runs with interrupts off and may not
+ * sleep, so it should only do what cannot wait and hand the rest
+ * to one of these:
+ *
+ * - softirq_raise() queues a "bottom half" that runs on the way
+ *   out of the current external interrupt, after the PIC has
+ *   been acknowledged and with interrupts back on.  It still runs
+ *   in interrupt context: intr_context() is true and it must not
+ *   sleep, but it may call intr_yield_on_return().
+ *
+ * - workqueue_submit() hands the work to a kernel worker thread,
+ *   where it may sleep, take locks and do I/O.  Work runs one
+ *   item at a time, in the order it was submitted.
+ *
+ * A struct work may be queued at most once at a time; queueing it
+ * again while it is still pending does nothing. */
+typedef void work_func (void *aux);
+
+struct work {
+	work_func *func;            /* Function to run. */
+	void *aux;                  /* Argument to FUNC. */
+	bool pending;               /* Queued and not yet started? */
+	struct list_elem elem;      /* softirq or workqueue list element. */
+};
+
+void work_init (struct work *, work_func *, void *aux);
+
+void softirq_init (void);
+bool softirq_raise (struct work *);
+void softirq_run (void);
+
+void workqueue_init (void);
+bool workqueue_submit (struct work *);
+
+#endif /* threads/workqueue.h */
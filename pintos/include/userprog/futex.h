@@ -0,0 +1,15 @@
+#ifndef USERPROG_FUTEX_H
+#define USERPROG_FUTEX_H
+
+#include <stdbool.h>
+#include "threads/thread.h"
+
+/* futex_wait() return value when the futex word is not resident:
+   the caller must fault it in and retry. */
+#define FUTEX_NOT_PRESENT (-2)
+
+void futex_init(void);
+int futex_wait(int *uaddr, int val);
+int futex_wake(struct thread *proc, int *uaddr, int cnt);
+
+#endif /* userprog/futex.h */
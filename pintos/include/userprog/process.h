@@ -9,6 +9,13 @@ int process_exec(void *f_name);
 int process_wait(tid_t);
 void process_exit(void);
 void process_activate(struct thread *next);
+tid_t process_thread_create(void *entry, void *arg, void *stack,
+                            int *clear_tid);
+void process_check_exit(void);
+void process_interrupt_threads(struct thread *proc);
+bool process_get_rusage(int who, struct rusage *ru);
+
+extern bool process_rusage_report;
 
 /* vm용 구조체 */
 #ifdef VM
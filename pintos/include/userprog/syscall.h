@@ -2,14 +2,16 @@
 #define USERPROG_SYSCALL_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "threads/interrupt.h"
 
 struct file;
-extern struct lock filesys_lock;
+extern struct rwlock filesys_lock;
 
 void syscall_init (void);
 void system_exit (int status);
 bool fdref_inc(struct file *fp);
 void fdref_dec(struct file *fp);
+bool user_copy_out(void *udst, const void *ksrc, size_t n);
 
 #endif /* userprog/syscall.h */
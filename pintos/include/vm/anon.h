@@ -16,5 +16,6 @@ struct anon_page {
 
 void vm_anon_init(void);
 bool anon_initializer(struct page *page, enum vm_type type, void *kva);
+void anon_share_slot(struct page *src, struct page *dst);
 
 #endif
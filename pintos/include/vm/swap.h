@@ -0,0 +1,17 @@
+#ifndef VM_SWAP_H
+#define VM_SWAP_H
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Swap slots hold one page each on the swap disk.  An unused
+   slot index is SIZE_MAX. */
+
+void swap_init(void);
+size_t swap_alloc(void);
+void swap_release(size_t *slotp);
+bool swap_share(const size_t *srcp, size_t *dstp);
+void swap_read(size_t slot, void *kva);
+void swap_write(size_t slot, const void *kva);
+void swap_print_stats(void);
+
+#endif /* vm/swap.h */
@@ -4,6 +4,7 @@
 
 #include "lib/kernel/hash.h"  // 해시테이블
 #include "threads/palloc.h"
+#include "threads/synch.h"
 //
 #include "vm/types.h"
 //
@@ -21,7 +22,9 @@
 struct page_operations;
 struct thread;
 struct frame;
+struct page;
 void vm_free_frame(struct frame *frame);
+void vm_wait_evicted(struct page *page);
 
 /* The representation of "page".
  * This is kind of "parent class", which has four "child class"es, which are
@@ -36,6 +39,9 @@ struct page {
   /* Your implementation */
   bool writable;  // 읽기 전용 혹은 읽기/쓰기 가능을 저장하기 위해 추가
   struct thread *owner;
+  bool cow;                   /* Mapped read-only to share its frame. */
+  struct list_elem cow_elem;  /* Element in frame's cow_pages. */
+  bool zero;                  /* Mapped read-only to the zero frame. */
 
   /* Per-type data are binded into the union.
    * Each function automatically detects the current union */
@@ -55,6 +61,11 @@ struct frame {
   struct page *page;
   struct list_elem frame_elem;
   bool in_table;
+  struct list cow_pages;  /* Pages other than PAGE sharing this frame. */
+  struct condition settled; /* Signaled, under frame_lock, when the frame
+                               enters frame_table or leaves it for good. */
+  int pin_cnt;            /* Kernel accesses through kva in progress. */
+  bool free_on_unpin;     /* vm_free_frame() was deferred by a pin. */
 };
 
 /* The function table for page operations.
@@ -90,6 +101,7 @@ bool spt_insert_page(struct supplemental_page_table *spt, struct page *page);
 void spt_remove_page(struct supplemental_page_table *spt, struct page *page);
 
 void vm_init(void);
+void vm_print_stats(void);
 bool vm_try_handle_fault(struct intr_frame *f, void *addr, bool user,
                          bool write, bool not_present);
 
@@ -100,6 +112,11 @@ bool vm_alloc_page_with_initializer(enum vm_type type, void *upage,
                                     void *aux);
 void vm_dealloc_page(struct page *page);
 bool vm_claim_page(void *va);
+bool vm_cow_break(struct page *page);
+bool vm_frame_unshare(struct page *page);
+bool vm_zero_break(struct page *page);
+struct frame *vm_pin_page(struct page *page);
+void vm_unpin_frame(struct frame *frame);
 enum vm_type page_get_type(struct page *page);
 
 #endif /* VM_VM_H */
@@ -0,0 +1,179 @@
+#include "heap.h"
+
+#include "../debug.h"
+
+/* A pairing heap is a tree in which every node is greater than or
+   equal to its children.  A node's children form a doubly linked
+   sibling list starting at its `child' link; the `prev' link of
+   the first child points back to the parent, which is what lets
+   heap_remove() unlink an arbitrary element in O(1).
+
+   Two heaps are joined by hanging the smaller root under the
+   greater one (link()).  Removing the root leaves a list of
+   subtrees, which are merged pairwise from left to right and then
+   folded together from right to left (merge_pairs()); this
+   two-pass merge is what gives the O(log n) amortized bound. */
+
+/* Returns true if A should be nearer the root than B. */
+static inline bool before(const struct heap *h, const struct heap_elem *a, const struct heap_elem *b) {
+  if (h->less(b, a, h->aux)) return true;
+  if (h->less(a, b, h->aux)) return false;
+  return a->seq < b->seq;
+}
+
+/* Joins the trees rooted at A and B, either of which may be null,
+   and returns the new root. */
+static struct heap_elem *link(const struct heap *h, struct heap_elem *a, struct heap_elem *b) {
+  if (a == NULL) return b;
+  if (b == NULL) return a;
+  if (before(h, b, a)) {
+    struct heap_elem *t = a;
+    a = b;
+    b = t;
+  }
+
+  /* B becomes A's first child. */
+  b->next = a->child;
+  if (a->child != NULL) a->child->prev = b;
+  b->prev = a;
+  a->child = b;
+  a->next = a->prev = NULL;
+  return a;
+}
+
+/* Merges the sibling list starting at FIRST into a single tree
+   and returns its root.  Iterative, so it is safe on the small
+   kernel stack however long the list is. */
+static struct heap_elem *merge_pairs(const struct heap *h, struct heap_elem *first) {
+  struct heap_elem *pairs = NULL; /* Merged pairs, last one first. */
+
+  while (first != NULL) {
+    struct heap_elem *a = first;
+    struct heap_elem *b = a->next;
+
+    first = b != NULL ? b->next : NULL;
+    a->next = a->prev = NULL;
+    if (b != NULL) b->next = b->prev = NULL;
+    a = link(h, a, b);
+    a->next = pairs;
+    pairs = a;
+  }
+
+  struct heap_elem *root = NULL;
+  while (pairs != NULL) {
+    struct heap_elem *p = pairs;
+
+    pairs = p->next;
+    p->next = NULL;
+    root = link(h, root, p);
+  }
+  return root;
+}
+
+/* Unlinks the subtree rooted at E, which is not the root, from
+   its parent or siblings. */
+static void detach(struct heap_elem *e) {
+  if (e->prev->child == e)
+    e->prev->child = e->next;
+  else
+    e->prev->next = e->next;
+  if (e->next != NULL) e->next->prev = e->prev;
+  e->next = e->prev = NULL;
+}
+
+/* Initializes H as an empty heap ordered by LESS given auxiliary
+   data AUX. */
+void heap_init(struct heap *h, heap_less_func *less, void *aux) {
+  ASSERT(h != NULL);
+  ASSERT(less != NULL);
+
+  h->root = NULL;
+  h->size = 0;
+  h->next_seq = 0;
+  h->less = less;
+  h->aux = aux;
+}
+
+/* Returns true if H is empty, false otherwise. */
+bool heap_empty(const struct heap *h) { return h->root == NULL; }
+
+/* Returns the number of elements in H. */
+size_t heap_size(const struct heap *h) { return h->size; }
+
+/* Inserts E into H. */
+void heap_push(struct heap *h, struct heap_elem *e) {
+  ASSERT(h != NULL);
+  ASSERT(e != NULL);
+
+  e->child = e->next = e->prev = NULL;
+  e->seq = h->next_seq++;
+  h->root = link(h, h->root, e);
+  h->size++;
+}
+
+/* Returns the greatest element of H, which must not be empty. */
+struct heap_elem *heap_top(const struct heap *h) {
+  ASSERT(!heap_empty(h));
+  return h->root;
+}
+
+/* Removes and returns the greatest element of H, which must not
+   be empty. */
+struct heap_elem *heap_pop(struct heap *h) {
+  struct heap_elem *top = heap_top(h);
+
+  h->root = merge_pairs(h, top->child);
+  h->size--;
+  top->child = NULL;
+  return top;
+}
+
+/* Removes E, which must be in H, from H. */
+void heap_remove(struct heap *h, struct heap_elem *e) {
+  ASSERT(h != NULL);
+  ASSERT(e != NULL);
+
+  if (e == h->root) {
+    heap_pop(h);
+    return;
+  }
+  detach(e);
+  h->root = link(h, h->root, merge_pairs(h, e->child));
+  h->size--;
+  e->child = NULL;
+}
+
+/* Restores heap order after the key of E, which must be in H, has
+   changed.  E keeps its place among equal elements. */
+void heap_update(struct heap *h, struct heap_elem *e) {
+  uint64_t seq = e->seq;
+
+  heap_remove(h, e);
+  e->seq = seq;
+  h->root = link(h, h->root, e);
+  h->size++;
+}
+
+/* Calls ACTION with AUX on every element of H, then rebuilds H.
+   ACTION may change keys but must not add or remove elements. */
+void heap_apply(struct heap *h, heap_action_func *action, void *aux) {
+  struct heap_elem *todo = h->root;
+
+  h->root = NULL;
+  while (todo != NULL) {
+    struct heap_elem *e = todo;
+    struct heap_elem *c = e->child;
+
+    /* E's children go on the work list; E is re-linked alone. */
+    todo = e->next;
+    while (c != NULL) {
+      struct heap_elem *next = c->next;
+      c->next = todo;
+      todo = c;
+      c = next;
+    }
+    e->child = e->next = e->prev = NULL;
+    action(e, aux);
+    h->root = link(h, h->root, e);
+  }
+}
@@ -0,0 +1,248 @@
+#include "rbtree.h"
+
+#include "../debug.h"
+
+/* A red-black tree is a binary search tree whose nodes are
+   colored so that (1) a red node has no red child and (2) every
+   path from a node down to a null link passes through the same
+   number of black nodes.  Together these keep the height below
+   2 log2(n + 1).  Insertion and removal restore the two rules
+   with at most three rotations plus recoloring up the tree
+   [CLRS, ch. 13].  Null links count as black. */
+
+static inline bool is_red(const struct rb_elem *e) { return e != NULL && e->red; }
+
+/* Puts NEW where OLD hangs from OLD's parent. */
+static void replace_child(struct rb_tree *t, struct rb_elem *old, struct rb_elem *new) {
+  struct rb_elem *parent = old->parent;
+
+  if (parent == NULL)
+    t->root = new;
+  else if (parent->left == old)
+    parent->left = new;
+  else
+    parent->right = new;
+  if (new != NULL) new->parent = parent;
+}
+
+/* Rotates the subtree rooted at X to the left: X's right child
+   takes X's place and X becomes its left child. */
+static void rotate_left(struct rb_tree *t, struct rb_elem *x) {
+  struct rb_elem *y = x->right;
+
+  x->right = y->left;
+  if (y->left != NULL) y->left->parent = x;
+  replace_child(t, x, y);
+  y->left = x;
+  x->parent = y;
+}
+
+/* Mirror image of rotate_left(). */
+static void rotate_right(struct rb_tree *t, struct rb_elem *x) {
+  struct rb_elem *y = x->left;
+
+  x->left = y->right;
+  if (y->right != NULL) y->right->parent = x;
+  replace_child(t, x, y);
+  y->right = x;
+  x->parent = y;
+}
+
+/* Returns the leftmost element of the subtree rooted at E. */
+static struct rb_elem *leftmost(struct rb_elem *e) {
+  while (e->left != NULL) e = e->left;
+  return e;
+}
+
+/* Initializes T as an empty tree ordered by LESS given auxiliary
+   data AUX. */
+void rb_init(struct rb_tree *t, rb_less_func *less, void *aux) {
+  ASSERT(t != NULL);
+  ASSERT(less != NULL);
+
+  t->root = NULL;
+  t->min = NULL;
+  t->size = 0;
+  t->less = less;
+  t->aux = aux;
+}
+
+/* Returns true if T is empty, false otherwise. */
+bool rb_empty(const struct rb_tree *t) { return t->root == NULL; }
+
+/* Returns the number of elements in T. */
+size_t rb_size(const struct rb_tree *t) { return t->size; }
+
+/* Inserts E into T, after any elements equal to it. */
+void rb_insert(struct rb_tree *t, struct rb_elem *e) {
+  struct rb_elem *parent = NULL;
+  struct rb_elem **link = &t->root;
+  bool is_min = true;
+
+  ASSERT(e != NULL);
+
+  while (*link != NULL) {
+    parent = *link;
+    if (t->less(e, parent, t->aux))
+      link = &parent->left;
+    else {
+      link = &parent->right;
+      is_min = false;
+    }
+  }
+  e->parent = parent;
+  e->left = e->right = NULL;
+  e->red = true;
+  *link = e;
+  if (is_min) t->min = e;
+  t->size++;
+
+  /* 빨강-빨강 충돌을 위로 올려가며 해소 */
+  while (is_red(e->parent)) {
+    struct rb_elem *p = e->parent;
+    struct rb_elem *g = p->parent; /* 부모가 빨강이면 루트가 아니므로 존재 */
+
+    if (p == g->left) {
+      struct rb_elem *uncle = g->right;
+      if (is_red(uncle)) {
+        p->red = uncle->red = false;
+        g->red = true;
+        e = g;
+        continue;
+      }
+      if (e == p->right) {
+        rotate_left(t, p);
+        e = p;
+        p = e->parent;
+      }
+      p->red = false;
+      g->red = true;
+      rotate_right(t, g);
+    } else {
+      struct rb_elem *uncle = g->left;
+      if (is_red(uncle)) {
+        p->red = uncle->red = false;
+        g->red = true;
+        e = g;
+        continue;
+      }
+      if (e == p->left) {
+        rotate_right(t, p);
+        e = p;
+        p = e->parent;
+      }
+      p->red = false;
+      g->red = true;
+      rotate_left(t, g);
+    }
+  }
+  t->root->red = false;
+}
+
+/* Removes E, which must be in T, from T. */
+void rb_remove(struct rb_tree *t, struct rb_elem *e) {
+  struct rb_elem *child, *parent;
+  bool removed_red;
+
+  ASSERT(e != NULL);
+  ASSERT(t->size > 0);
+
+  if (t->min == e) t->min = rb_next(e);
+
+  if (e->left == NULL || e->right == NULL) {
+    /* 자식이 하나 이하: 그 자식이 E 자리를 차지 */
+    child = e->left != NULL ? e->left : e->right;
+    parent = e->parent;
+    removed_red = e->red;
+    replace_child(t, e, child);
+  } else {
+    /* 자식이 둘: 오른쪽 서브트리의 최솟값 S가 E 자리로 옮겨오고,
+       색 규칙은 S가 원래 있던 자리에서 복구한다 */
+    struct rb_elem *s = leftmost(e->right);
+
+    child = s->right;
+    removed_red = s->red;
+    if (s->parent == e)
+      parent = s;
+    else {
+      parent = s->parent;
+      replace_child(t, s, child);
+      s->right = e->right;
+      s->right->parent = s;
+    }
+    replace_child(t, e, s);
+    s->left = e->left;
+    s->left->parent = s;
+    s->red = e->red;
+  }
+  t->size--;
+  if (removed_red) return;
+
+  /* 검정 노드가 빠져 CHILD 쪽 경로의 검정 수가 하나 모자람 */
+  while (child != t->root && !is_red(child)) {
+    if (child == parent->left) {
+      struct rb_elem *sib = parent->right;
+      if (is_red(sib)) {
+        sib->red = false;
+        parent->red = true;
+        rotate_left(t, parent);
+        sib = parent->right;
+      }
+      if (!is_red(sib->left) && !is_red(sib->right)) {
+        sib->red = true;
+        child = parent;
+        parent = child->parent;
+        continue;
+      }
+      if (!is_red(sib->right)) {
+        sib->left->red = false;
+        sib->red = true;
+        rotate_right(t, sib);
+        sib = parent->right;
+      }
+      sib->red = parent->red;
+      parent->red = false;
+      sib->right->red = false;
+      rotate_left(t, parent);
+    } else {
+      struct rb_elem *sib = parent->left;
+      if (is_red(sib)) {
+        sib->red = false;
+        parent->red = true;
+        rotate_right(t, parent);
+        sib = parent->left;
+      }
+      if (!is_red(sib->left) && !is_red(sib->right)) {
+        sib->red = true;
+        child = parent;
+        parent = child->parent;
+        continue;
+      }
+      if (!is_red(sib->left)) {
+        sib->right->red = false;
+        sib->red = true;
+        rotate_left(t, sib);
+        sib = parent->left;
+      }
+      sib->red = parent->red;
+      parent->red = false;
+      sib->left->red = false;
+      rotate_right(t, parent);
+    }
+    child = t->root;
+    break;
+  }
+  if (child != NULL) child->red = false;
+}
+
+/* Returns the least element of T, or a null pointer if T is
+   empty.  O(1). */
+struct rb_elem *rb_min(const struct rb_tree *t) { return t->min; }
+
+/* Returns the element following E in T's order, or a null pointer
+   if E is the greatest. */
+struct rb_elem *rb_next(const struct rb_elem *e) {
+  if (e->right != NULL) return leftmost(e->right);
+  while (e->parent != NULL && e == e->parent->right) e = e->parent;
+  return e->parent;
+}
@@ -0,0 +1,170 @@
+#include <pthread.h>
+#include <limits.h>
+#include <stdint.h>
+#include <syscall.h>
+
+/* One thread.  The kernel stores 0 in TID_WORD when the thread
+   exits and wakes any futex waiter on it, which is all that
+   pthread_join() needs. */
+struct pthread {
+	int used;                    /* Slot taken (until joined). */
+	int tid_word;                /* Nonzero while the thread runs. */
+	void *(*start) (void *);     /* Thread function and its argument. */
+	void *arg;
+	void *retval;                /* Value passed to pthread_exit(). */
+	uint8_t stack[PTHREAD_STACK_SIZE] __attribute__ ((aligned (16)));
+};
+
+static struct pthread threads[PTHREAD_MAX];
+
+/* Returns the calling thread's slot, found from its stack
+   pointer, or a null pointer for the initial thread. */
+static struct pthread *
+self (void) {
+	uint8_t *sp = __builtin_frame_address (0);
+	for (int i = 0; i < PTHREAD_MAX; i++)
+		if (sp >= threads[i].stack && sp < threads[i].stack + PTHREAD_STACK_SIZE)
+			return &threads[i];
+	return NULL;
+}
+
+static void
+start_thread (void *t_) {
+	struct pthread *t = t_;
+	pthread_exit (t->start (t->arg));
+}
+
+/* Starts a thread running START(ARG) and stores its handle in
+   *THREAD.  Returns 0 if successful, -1 if no slot is free or the
+   kernel refused. */
+int
+pthread_create (pthread_t *thread, void *(*start) (void *), void *arg) {
+	struct pthread *t = NULL;
+
+	for (int i = 0; i < PTHREAD_MAX && t == NULL; i++) {
+		int unused = 0;
+		if (__atomic_compare_exchange_n (&threads[i].used, &unused, 1, false,
+		                                 __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+			t = &threads[i];
+	}
+	if (t == NULL)
+		return -1;
+
+	t->start = start;
+	t->arg = arg;
+	t->retval = NULL;
+	t->tid_word = 1;
+
+	/* The new thread enters start_thread() as if called from a
+	   function, so leave room for a (fake) return address. */
+	uint64_t *sp = (uint64_t *) (t->stack + PTHREAD_STACK_SIZE) - 1;
+	*sp = 0;
+
+	if (thread_create (start_thread, t, sp, &t->tid_word) < 0) {
+		__atomic_store_n (&t->used, 0, __ATOMIC_RELEASE);
+		return -1;
+	}
+	*thread = t;
+	return 0;
+}
+
+/* Waits for THREAD to exit and frees its slot.  Stores the value
+   it passed to pthread_exit() in *RETVAL if RETVAL is non-null. */
+int
+pthread_join (pthread_t thread, void **retval) {
+	int word;
+
+	while ((word = __atomic_load_n (&thread->tid_word, __ATOMIC_ACQUIRE)) != 0)
+		futex_wait (&thread->tid_word, word);
+
+	if (retval != NULL)
+		*retval = thread->retval;
+	__atomic_store_n (&thread->used, 0, __ATOMIC_RELEASE);
+	return 0;
+}
+
+/* Exits the calling thread with RETVAL.  In the initial thread
+   this exits the whole process, as with exit(0). */
+void
+pthread_exit (void *retval) {
+	struct pthread *t = self ();
+
+	if (t != NULL)
+		t->retval = retval;
+	thread_exit ();
+}
+
+int
+pthread_mutex_init (pthread_mutex_t *m) {
+	m->state = 0;
+	return 0;
+}
+
+/* Three-state futex mutex (Drepper, "Futexes Are Tricky"): the
+   uncontended lock and unlock never enter the kernel. */
+int
+pthread_mutex_lock (pthread_mutex_t *m) {
+	int c = 0;
+
+	if (__atomic_compare_exchange_n (&m->state, &c, 1, false,
+	                                 __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		return 0;
+	if (c != 2)
+		c = __atomic_exchange_n (&m->state, 2, __ATOMIC_ACQUIRE);
+	while (c != 0) {
+		futex_wait (&m->state, 2);
+		c = __atomic_exchange_n (&m->state, 2, __ATOMIC_ACQUIRE);
+	}
+	return 0;
+}
+
+int
+pthread_mutex_trylock (pthread_mutex_t *m) {
+	int c = 0;
+	return __atomic_compare_exchange_n (&m->state, &c, 1, false,
+	                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)
+	       ? 0 : -1;
+}
+
+int
+pthread_mutex_unlock (pthread_mutex_t *m) {
+	if (__atomic_exchange_n (&m->state, 0, __ATOMIC_RELEASE) == 2)
+		futex_wake (&m->state, 1);
+	return 0;
+}
+
+int
+pthread_cond_init (pthread_cond_t *c) {
+	c->seq = 0;
+	return 0;
+}
+
+/* Releases M, waits for a signal on C, and reacquires M.  As with
+   POSIX, wakeups may be spurious. */
+int
+pthread_cond_wait (pthread_cond_t *c, pthread_mutex_t *m) {
+	int seq = __atomic_load_n (&c->seq, __ATOMIC_RELAXED);
+
+	pthread_mutex_unlock (m);
+	futex_wait (&c->seq, seq);
+
+	/* Someone else may be waiting for M too, so take it in the
+	   contended state. */
+	while (__atomic_exchange_n (&m->state, 2, __ATOMIC_ACQUIRE) != 0)
+		futex_wait (&m->state, 2);
+	return 0;
+}
+
+int
+pthread_cond_signal (pthread_cond_t *c) {
+	__atomic_add_fetch (&c->seq, 1, __ATOMIC_RELEASE);
+	futex_wake (&c->seq, 1);
+	return 0;
+}
+
+int
+pthread_cond_broadcast (pthread_cond_t *c) {
+	__atomic_add_fetch (&c->seq, 1, __ATOMIC_RELEASE);
+	futex_wake (&c->seq, INT_MAX);
+	return 0;
+}
@@ -0,0 +1,29 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+# Parses the output of an adaptive-mix test, by default the one
+# being checked, and returns the average batch slice, in ticks,
+# and the mean and maximum interactive wakeup latencies, in
+# microseconds.
+sub get_mix_results {
+    our ($test);
+    my ($name) = @_;
+    $name = $test if !defined $name;
+    my (@output) = read_text_file ("$name.output");
+    common_checks ("run", @output);
+    @output = get_core_output ("run", @output);
+
+    my ($slice, $mean, $max);
+    foreach (@output) {
+	$slice = $1 if /(\d+\.\d+) ticks per slice/;
+	($mean, $max) = ($1, $2)
+	  if /mean wakeup latency (\d+) us, max (\d+) us/;
+    }
+    fail "missing batch results\n" if !defined $slice;
+    fail "missing interactive results\n" if !defined $mean;
+    return ($slice, $mean, $max);
+}
+
+1;
@@ -0,0 +1,10 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+use tests::threads::adaptive;
+
+# The fixed-slice scheduler is the baseline: only check that the
+# benchmark ran and produced numbers.
+get_mix_results ();
+pass;
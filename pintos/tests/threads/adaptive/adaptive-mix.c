@@ -0,0 +1,154 @@
+/* Benchmarks how the scheduler treats a mix of CPU-bound and
+   interactive threads.
+
+   Phase 1 runs BATCH_CNT CPU-bound threads for BATCH_TICKS ticks
+   and reports how long each of them ran, on average, before being
+   switched out.  Phase 2 runs the same load next to a thread that
+   repeatedly sleeps for 2 ticks, like one waiting for the console
+   or the disk, and reports how long that thread took to run after
+   each wakeup.
+
+   adaptive-mix-base runs the plain priority scheduler, where every
+   thread gets a fixed 4-tick slice and a waking thread waits
+   behind the CPU-bound ones.  adaptive-mix runs under -adaptive,
+   which should stretch the CPU-bound threads' slices and let the
+   interactive thread run almost as soon as it wakes. */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+
+#define BATCH_CNT 3
+#define BATCH_TICKS (4 * TIMER_FREQ)
+#define WAKEUP_CNT 30
+#define WARMUP_CNT 5
+
+struct batch_info 
+  {
+    int64_t ticks;              /* Ticks during which it ran. */
+    int64_t switches;           /* Times it was preempted. */
+  };
+
+static struct semaphore done;
+
+static void run_mix (void);
+static void batch_thread (void *);
+static void interactive_thread (void *);
+
+void
+test_adaptive_mix_base (void) 
+{
+  ASSERT (!thread_adaptive && !thread_mlfqs && !thread_cfs);
+  run_mix ();
+}
+
+void
+test_adaptive_mix (void) 
+{
+  ASSERT (thread_adaptive);
+  run_mix ();
+}
+
+static void
+run_mix (void) 
+{
+  struct batch_info info[BATCH_CNT];
+  uint64_t latency[2];          /* Mean and maximum, in us. */
+  int64_t ticks = 0, slices = 0;
+  int i;
+
+  sema_init (&done, 0);
+
+  msg ("Phase 1: %d CPU-bound threads for %d ticks...", BATCH_CNT,
+       BATCH_TICKS);
+  for (i = 0; i < BATCH_CNT; i++)
+    thread_create ("batch", PRI_DEFAULT, batch_thread, &info[i]);
+  for (i = 0; i < BATCH_CNT; i++)
+    sema_down (&done);
+  for (i = 0; i < BATCH_CNT; i++) 
+    {
+      ticks += info[i].ticks;
+      slices += info[i].switches + 1;
+    }
+  msg ("batch: %"PRId64" ticks in %"PRId64" slices, "
+       "%"PRId64".%"PRId64" ticks per slice",
+       ticks, slices, ticks / slices, ticks * 10 / slices % 10);
+
+  msg ("Phase 2: the same load plus an interactive thread...");
+  for (i = 0; i < BATCH_CNT; i++)
+    thread_create ("batch", PRI_DEFAULT, batch_thread, &info[i]);
+  thread_create ("interactive", PRI_DEFAULT, interactive_thread, latency);
+  for (i = 0; i < BATCH_CNT + 1; i++)
+    sema_down (&done);
+  msg ("interactive: mean wakeup latency %"PRIu64" us, max %"PRIu64" us",
+       latency[0], latency[1]);
+}
+
+/* Spins for BATCH_TICKS, counting the ticks it sees and the
+   times it is preempted. */
+static void
+batch_thread (void *info_) 
+{
+  struct batch_info *info = info_;
+  struct thread *t = thread_current ();
+  uint64_t switches = t->ru.nivcsw;
+  int64_t start = timer_ticks ();
+  int64_t last = start;
+
+  info->ticks = 0;
+  while (timer_elapsed (start) < BATCH_TICKS) 
+    {
+      int64_t now = timer_ticks ();
+      if (now != last)
+        info->ticks++;
+      last = now;
+    }
+  info->switches = t->ru.nivcsw - switches;
+  sema_up (&done);
+}
+
+static struct semaphore wakeup;
+static uint64_t wakeup_ns;
+
+static void
+wake (void *aux UNUSED) 
+{
+  wakeup_ns = timer_now_ns ();
+  sema_up (&wakeup);
+}
+
+/* Sleeps 2 ticks at a time, WAKEUP_CNT times, and measures how
+   long it takes to run again after each timer expiry.  The first
+   WARMUP_CNT wakeups are not counted, to give the scheduler time
+   to learn that this thread is interactive. */
+static void
+interactive_thread (void *latency_) 
+{
+  uint64_t *latency = latency_;
+  uint64_t sum = 0, max = 0;
+  struct timer timer;
+  int i;
+
+  sema_init (&wakeup, 0);
+  timer_setup (&timer, wake, NULL);
+  for (i = 0; i < WARMUP_CNT + WAKEUP_CNT; i++) 
+    {
+      uint64_t ns;
+
+      timer_add (&timer, timer_ticks () + 2);
+      sema_down (&wakeup);
+      ns = timer_now_ns () - wakeup_ns;
+      if (i < WARMUP_CNT)
+        continue;
+      sum += ns;
+      if (ns > max)
+        max = ns;
+    }
+  latency[0] = sum / WAKEUP_CNT / 1000;
+  latency[1] = max / 1000;
+  sema_up (&done);
+}
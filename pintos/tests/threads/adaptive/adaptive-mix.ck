@@ -0,0 +1,28 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+use tests::threads::adaptive;
+
+our ($test);
+my ($slice, $mean, $max) = get_mix_results ();
+my ($base_slice, $base_mean) = get_mix_results ("$test-base");
+
+# CPU-bound threads should reach 4x the 4-tick base slice after a
+# few slices, so the average must be well above the base, and at
+# least twice what the fixed-slice scheduler achieved.
+fail "batch threads averaged only $slice ticks per slice\n"
+  if $slice < 8;
+fail "batch slices averaged $slice ticks, not twice the "
+  . "$base_slice ticks of adaptive-mix-base\n"
+  if $slice < 2 * $base_slice;
+
+# Once boosted, the interactive thread should preempt the batch
+# threads right away instead of waiting up to 3 slices, at least
+# halving the fixed-slice scheduler's mean latency.
+fail "mean wakeup latency is $mean us, should be under a tick\n"
+  if $mean >= 10000;
+fail "mean wakeup latency is $mean us, not half the "
+  . "$base_mean us of adaptive-mix-base\n"
+  if $mean > $base_mean / 2;
+pass;
@@ -0,0 +1,64 @@
+/* Arms kernel timers directly and checks timer_cancel(): a
+   cancelled timer, whether on the first level of the timer wheel
+   or a higher one, never fires; cancelling reports whether the
+   timer was still pending; and re-adding a pending timer moves it
+   instead of arming it twice. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+
+static int near_cnt, far_cnt, kept_cnt, moved_cnt;
+
+/* Counts the times a timer fired. */
+static void
+count_fire (void *cnt_) 
+{
+  int *cnt = cnt_;
+  (*cnt)++;
+}
+
+void
+test_alarm_cancel (void) 
+{
+  struct timer near, far, kept, moved;
+  int64_t start;
+
+  timer_setup (&near, count_fire, &near_cnt);
+  timer_setup (&far, count_fire, &far_cnt);
+  timer_setup (&kept, count_fire, &kept_cnt);
+  timer_setup (&moved, count_fire, &moved_cnt);
+
+  msg ("Cancelling a timer that was never armed.");
+  if (timer_cancel (&near))
+    fail ("an unarmed timer was reported pending");
+
+  start = timer_ticks ();
+  timer_add (&near, start + 20);
+  timer_add (&far, start + 300);
+  timer_add (&kept, start + 40);
+  timer_add (&moved, start + 10);
+  timer_add (&moved, start + 60);
+
+  msg ("Cancelling two of four armed timers.");
+  if (!timer_cancel (&near))
+    fail ("level-0 timer was not reported pending");
+  if (!timer_cancel (&far))
+    fail ("higher-level timer was not reported pending");
+
+  timer_sleep (start + 30 - timer_ticks ());
+  if (moved_cnt != 0)
+    fail ("moved timer fired at its old deadline");
+
+  timer_sleep (start + 350 - timer_ticks ());
+  msg ("Timers fired: near %d, far %d, kept %d, moved %d.",
+       near_cnt, far_cnt, kept_cnt, moved_cnt);
+
+  msg ("Cancelling timers that already fired or were cancelled.");
+  if (timer_cancel (&kept) || timer_cancel (&moved))
+    fail ("a fired timer was reported pending");
+  if (timer_cancel (&near) || timer_cancel (&far))
+    fail ("a cancelled timer was reported pending");
+}
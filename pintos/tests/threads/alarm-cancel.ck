@@ -0,0 +1,13 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(alarm-cancel) begin
+(alarm-cancel) Cancelling a timer that was never armed.
+(alarm-cancel) Cancelling two of four armed timers.
+(alarm-cancel) Timers fired: near 0, far 0, kept 1, moved 1.
+(alarm-cancel) Cancelling timers that already fired or were cancelled.
+(alarm-cancel) end
+EOF
+pass;
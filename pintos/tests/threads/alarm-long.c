@@ -0,0 +1,65 @@
+/* Creates threads that sleep for more than the 256 ticks that the
+   first level of the timer wheel covers, so that their timers have
+   to be cascaded down from a higher level, and checks that each
+   one wakes up on the tick it asked for.  The sleeps start off a
+   level-0 revolution boundary so that cascading has to split
+   them across slots. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+
+static thread_func alarm_long_thread;
+static int64_t start_time;
+static struct semaphore wait_sema;
+
+static const int durations[] = {255, 256, 257, 700, 1300};
+#define THREAD_CNT (int) (sizeof durations / sizeof *durations)
+
+void
+test_alarm_long (void) 
+{
+  int i;
+
+  /* This test does not work with the MLFQS. */
+  ASSERT (!thread_mlfqs);
+
+  sema_init (&wait_sema, 0);
+  start_time = timer_ticks () + 37;
+  for (i = 0; i < THREAD_CNT; i++)
+    {
+      char name[16];
+      snprintf (name, sizeof name, "sleeper %d", i);
+      thread_create (name, PRI_DEFAULT, alarm_long_thread,
+                     (void *) &durations[i]);
+    }
+
+  for (i = 0; i < THREAD_CNT; i++)
+    sema_down (&wait_sema);
+}
+
+static void
+alarm_long_thread (void *duration_) 
+{
+  int duration = *(const int *) duration_;
+  int64_t wake_time = start_time + duration;
+  int64_t now;
+
+  timer_sleep (wake_time - timer_ticks ());
+  now = timer_ticks ();
+
+  /* timer_sleep() may start counting one tick late if a tick
+     arrives while it is being called, but never early. */
+  if (now < wake_time)
+    fail ("sleep of %d ticks woke up %lld ticks early",
+          duration, wake_time - now);
+  if (now > wake_time + 1)
+    fail ("sleep of %d ticks woke up %lld ticks late",
+          duration, now - wake_time);
+  msg ("Thread sleeping %d ticks woke up.", duration);
+
+  sema_up (&wait_sema);
+}
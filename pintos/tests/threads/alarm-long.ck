@@ -0,0 +1,14 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(alarm-long) begin
+(alarm-long) Thread sleeping 255 ticks woke up.
+(alarm-long) Thread sleeping 256 ticks woke up.
+(alarm-long) Thread sleeping 257 ticks woke up.
+(alarm-long) Thread sleeping 700 ticks woke up.
+(alarm-long) Thread sleeping 1300 ticks woke up.
+(alarm-long) end
+EOF
+pass;
@@ -0,0 +1,59 @@
+/* Runs with -nohz, so the periodic tick stops whenever every
+   thread is asleep, and checks that the ticks counted afterward
+   still match the time that passed as measured by the TSC: across
+   one long idle period, and across many short ones with a thread
+   waking up in between. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+
+#define NS_PER_TICK (1000000000 / TIMER_FREQ)
+
+static void check_idle (const char *what, int sleeps, int ticks);
+
+void
+test_alarm_nohz (void) 
+{
+  ASSERT (timer_nohz);
+
+  check_idle ("one 500-tick sleep", 1, 500);
+  check_idle ("100 sleeps of 3 ticks", 100, 3);
+  check_idle ("20 sleeps of 13 ticks", 20, 13);
+}
+
+/* Sleeps SLEEPS times for TICKS ticks each and fails unless the
+   ticks counted meanwhile agree with the TSC, to within a tick
+   plus one percent, and no sleep woke up early. */
+static void
+check_idle (const char *what, int sleeps, int ticks) 
+{
+  int64_t start, ticks_elapsed, tsc_ticks, slack;
+  uint64_t start_ns;
+  int i;
+
+  /* Start at the very beginning of a tick. */
+  start = timer_ticks ();
+  while (timer_elapsed (start) == 0)
+    continue;
+  start = timer_ticks ();
+  start_ns = timer_now_ns ();
+
+  for (i = 0; i < sleeps; i++)
+    {
+      int64_t wake_time = timer_ticks () + ticks;
+      timer_sleep (ticks);
+      if (timer_ticks () < wake_time)
+        fail ("%s: sleep %d woke up early", what, i);
+    }
+
+  ticks_elapsed = timer_elapsed (start);
+  tsc_ticks = (timer_now_ns () - start_ns) / NS_PER_TICK;
+  slack = 1 + tsc_ticks / 100;
+  if (ticks_elapsed < tsc_ticks - slack || ticks_elapsed > tsc_ticks + slack)
+    fail ("%s: counted %lld ticks but %lld passed", what,
+          ticks_elapsed, tsc_ticks);
+  msg ("%s: ticks match the TSC.", what);
+}
@@ -0,0 +1,12 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(alarm-nohz) begin
+(alarm-nohz) one 500-tick sleep: ticks match the TSC.
+(alarm-nohz) 100 sleeps of 3 ticks: ticks match the TSC.
+(alarm-nohz) 20 sleeps of 13 ticks: ticks match the TSC.
+(alarm-nohz) end
+EOF
+pass;
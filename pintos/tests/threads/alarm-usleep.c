@@ -0,0 +1,78 @@
+/* Sleeps for less than a tick with timer_usleep() and
+   timer_nsleep() and checks, against the TSC, that each sleep
+   lasts at least as long as asked and ends within a fifth of a
+   tick of its deadline.  A lower-priority thread counts while we sleep,
+   so it only makes progress if the sleeps block instead of
+   spinning. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+
+/* Latest acceptable wakeup after the deadline. */
+#define SLACK_NS (1000000000 / TIMER_FREQ / 5)
+
+static volatile bool stop;
+static volatile long long spin_cnt;
+static struct semaphore spinner_done;
+
+static void
+spinner (void *aux UNUSED) 
+{
+  while (!stop)
+    spin_cnt++;
+  sema_up (&spinner_done);
+}
+
+/* Sleeps NS nanoseconds, with timer_usleep() if USEC, and checks
+   how long the sleep took and that the spinner ran meanwhile. */
+static void
+check_sleep (int64_t ns, bool usec) 
+{
+  long long spun = spin_cnt;
+  uint64_t start = timer_cycles ();
+  uint64_t elapsed;
+
+  if (usec)
+    timer_usleep (ns / 1000);
+  else
+    timer_nsleep (ns);
+  elapsed = (timer_cycles () - start) * 1000000000 / timer_cycles_hz ();
+
+  if (elapsed < (uint64_t) ns)
+    fail ("%lld ns sleep woke after only %llu ns",
+          (long long) ns, (unsigned long long) elapsed);
+  if (elapsed > (uint64_t) ns + SLACK_NS)
+    fail ("%lld ns sleep woke after %llu ns",
+          (long long) ns, (unsigned long long) elapsed);
+  if (spin_cnt == spun)
+    fail ("%lld ns sleep did not let another thread run", (long long) ns);
+}
+
+void
+test_alarm_usleep (void) 
+{
+  static const int64_t sleeps[] = {100000, 300000, 1000000, 2500000, 6000000};
+  size_t i;
+
+  /* This test does not work with the MLFQS. */
+  ASSERT (!thread_mlfqs);
+
+  sema_init (&spinner_done, 0);
+  thread_create ("spinner", PRI_DEFAULT - 1, spinner, NULL);
+
+  msg ("Sleeping for less than a tick with timer_usleep().");
+  for (i = 0; i < sizeof sleeps / sizeof *sleeps; i++)
+    check_sleep (sleeps[i], true);
+
+  msg ("Sleeping for less than a tick with timer_nsleep().");
+  for (i = 0; i < sizeof sleeps / sizeof *sleeps; i++)
+    check_sleep (sleeps[i] + 12345, false);
+
+  msg ("Every sleep blocked and woke on time.");
+  stop = true;
+  sema_down (&spinner_done);
+}
@@ -0,0 +1,12 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(alarm-usleep) begin
+(alarm-usleep) Sleeping for less than a tick with timer_usleep().
+(alarm-usleep) Sleeping for less than a tick with timer_nsleep().
+(alarm-usleep) Every sleep blocked and woke on time.
+(alarm-usleep) end
+EOF
+pass;
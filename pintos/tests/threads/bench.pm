@@ -0,0 +1,26 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+# Checks that a benchmark ran to completion and printed a BENCH
+# line for each metric in @METRICS.  Benchmarks do not pass or
+# fail on their numbers; use "make bench" and tests/bench-compare
+# to look for regressions.
+sub check_bench {
+    my (@metrics) = @_;
+    our ($test);
+    my (@output) = read_text_file ("$test.output");
+    common_checks ("run", @output);
+    @output = get_core_output ("run", @output);
+
+    my (%seen);
+    foreach (@output) {
+	$seen{$1} = 1 if /^BENCH (\S+) n=\d+ /;
+    }
+    my (@missing) = grep (!$seen{$_}, @metrics);
+    fail "missing results for @missing\n" if @missing;
+    pass;
+}
+
+1;
@@ -0,0 +1,8 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+use tests::threads::bench;
+
+check_bench (map ("donate.depth-$_.acquire", 1, 2, 4, 8),
+	     map ("donate.depth-$_.release", 1, 2, 4, 8));
@@ -0,0 +1,59 @@
+/* Timer wakeup precision benchmark.
+
+   Measures how long timer_sleep(1) and timer_usleep() of 100 us
+   and 1 ms actually keep the calling thread off the CPU, from
+   the call to the moment it runs again.  The tick sleep starts
+   right after a tick boundary, so the ideal sample is exactly
+   one tick (10 ms); anything above the requested time is wakeup
+   latency. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "tests/threads/bench/bench.h"
+#include "threads/init.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+
+#define TICK_ITERS 50
+#define USLEEP_ITERS 200
+
+static uint64_t samples[USLEEP_ITERS];
+
+static void
+run_usleep (const char *name, int64_t us) 
+{
+  struct bench b;
+  int i;
+
+  bench_init (&b, name, "ns", samples, USLEEP_ITERS);
+  for (i = 0; i < USLEEP_ITERS; i++) 
+    {
+      uint64_t start = timer_now_ns ();
+      timer_usleep (us);
+      bench_add (&b, timer_now_ns () - start);
+    }
+  bench_report (&b);
+}
+
+void
+test_bench_sleep (void) 
+{
+  struct bench b;
+  int i;
+
+  bench_init (&b, "sleep.tick-1", "ns", samples, TICK_ITERS);
+  for (i = 0; i < TICK_ITERS; i++) 
+    {
+      uint64_t start;
+
+      /* Line up with a tick boundary first. */
+      timer_sleep (1);
+      start = timer_now_ns ();
+      timer_sleep (1);
+      bench_add (&b, timer_now_ns () - start);
+    }
+  bench_report (&b);
+
+  run_usleep ("sleep.usleep-100", 100);
+  run_usleep ("sleep.usleep-1000", 1000);
+}
@@ -0,0 +1,7 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+use tests::threads::bench;
+
+check_bench ("sleep.tick-1", "sleep.usleep-100", "sleep.usleep-1000");
@@ -0,0 +1,267 @@
+/* Synchronization primitive microbenchmarks.
+
+   bench-sema times an uncontended sema_down()/sema_up() pair and
+   a semaphore ping-pong between two threads of equal priority.
+
+   bench-lock times an uncontended lock_acquire()/lock_release()
+   pair and a handoff: releasing a lock that a higher-priority
+   thread is blocked on, up to the point that thread has taken
+   and released it and gone back to sleep.
+
+   bench-condvar times a condition variable ping-pong between two
+   threads that share one lock.
+
+   bench-donate builds priority donation chains of depth 1, 2, 4
+   and 8 and times both the lock_acquire() that donates down the
+   whole chain and the lock_release() that unwinds it. */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "tests/threads/tests.h"
+#include "tests/threads/bench/bench.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+
+#define WARMUP 16
+#define ITERS 256
+
+static uint64_t samples[ITERS];
+
+/* Times one iteration of a simple operation OP. */
+#define TIME_LOOP(B, OP)                                \
+  do                                                    \
+    {                                                   \
+      int i_;                                           \
+      for (i_ = 0; i_ < WARMUP + ITERS; i_++)           \
+        {                                               \
+          uint64_t start_ = bench_cycles ();            \
+          OP;                                           \
+          if (i_ >= WARMUP)                             \
+            bench_add (B, bench_cycles () - start_);    \
+        }                                               \
+    }                                                   \
+  while (0)
+
+static struct semaphore ping, pong;
+
+static void
+sema_thread (void *aux UNUSED) 
+{
+  int i;
+
+  for (i = 0; i < WARMUP + ITERS; i++) 
+    {
+      sema_down (&ping);
+      sema_up (&pong);
+    }
+}
+
+void
+test_bench_sema (void) 
+{
+  struct semaphore sema;
+  struct bench b;
+
+  ASSERT (!thread_mlfqs && !thread_cfs);
+
+  sema_init (&sema, 0);
+  bench_init (&b, "sema.uncontended", "cycles", samples, ITERS);
+  TIME_LOOP (&b, (sema_up (&sema), sema_down (&sema)));
+  bench_report (&b);
+
+  sema_init (&ping, 0);
+  sema_init (&pong, 0);
+  thread_create ("pong", PRI_DEFAULT, sema_thread, NULL);
+  bench_init (&b, "sema.round-trip", "cycles", samples, ITERS);
+  TIME_LOOP (&b, (sema_up (&ping), sema_down (&pong)));
+  bench_report (&b);
+}
+
+static struct lock lock;
+static struct semaphore go;
+
+static void
+lock_thread (void *aux UNUSED) 
+{
+  int i;
+
+  for (i = 0; i < WARMUP + ITERS; i++) 
+    {
+      sema_down (&go);
+      lock_acquire (&lock);
+      lock_release (&lock);
+    }
+}
+
+void
+test_bench_lock (void) 
+{
+  struct bench b;
+  int i;
+
+  ASSERT (!thread_mlfqs && !thread_cfs);
+
+  lock_init (&lock);
+  bench_init (&b, "lock.uncontended", "cycles", samples, ITERS);
+  TIME_LOOP (&b, (lock_acquire (&lock), lock_release (&lock)));
+  bench_report (&b);
+
+  sema_init (&go, 0);
+  thread_create ("waiter", PRI_DEFAULT + 1, lock_thread, NULL);
+  bench_init (&b, "lock.handoff", "cycles", samples, ITERS);
+  for (i = 0; i < WARMUP + ITERS; i++) 
+    {
+      uint64_t start;
+
+      /* The waiter preempts us on sema_up() and blocks on the
+         lock, donating its priority. */
+      lock_acquire (&lock);
+      sema_up (&go);
+      start = bench_cycles ();
+      lock_release (&lock);
+      if (i >= WARMUP)
+        bench_add (&b, bench_cycles () - start);
+    }
+  bench_report (&b);
+}
+
+static struct condition cond;
+static int turn;
+
+static void
+condvar_thread (void *aux UNUSED) 
+{
+  int i;
+
+  lock_acquire (&lock);
+  for (i = 0; i < WARMUP + ITERS; i++) 
+    {
+      while (turn != 1)
+        cond_wait (&cond, &lock);
+      turn = 0;
+      cond_signal (&cond, &lock);
+    }
+  lock_release (&lock);
+}
+
+void
+test_bench_condvar (void) 
+{
+  struct bench b;
+  int i;
+
+  ASSERT (!thread_mlfqs && !thread_cfs);
+
+  lock_init (&lock);
+  cond_init (&cond);
+  turn = 0;
+  thread_create ("condvar", PRI_DEFAULT, condvar_thread, NULL);
+
+  bench_init (&b, "condvar.round-trip", "cycles", samples, ITERS);
+  lock_acquire (&lock);
+  for (i = 0; i < WARMUP + ITERS; i++) 
+    {
+      uint64_t start = bench_cycles ();
+      turn = 1;
+      cond_signal (&cond, &lock);
+      while (turn != 0)
+        cond_wait (&cond, &lock);
+      if (i >= WARMUP)
+        bench_add (&b, bench_cycles () - start);
+    }
+  lock_release (&lock);
+  bench_report (&b);
+}
+
+#define DONATE_DEPTH_MAX 8
+#define DONATE_ITERS 64
+
+static struct lock chain[DONATE_DEPTH_MAX];
+static uint64_t acquire_start;
+
+/* Holds lock I and blocks on lock I - 1, passing on any
+   donation it receives. */
+static void
+chain_thread (void *i_) 
+{
+  int i = (intptr_t) i_;
+
+  lock_acquire (&chain[i]);
+  lock_acquire (&chain[i - 1]);
+  lock_release (&chain[i - 1]);
+  lock_release (&chain[i]);
+}
+
+/* Blocks on the last lock in a chain of DEPTH locks, donating
+   its priority down to the main thread. */
+static void
+top_thread (void *depth_) 
+{
+  int depth = (intptr_t) depth_;
+
+  acquire_start = bench_cycles ();
+  lock_acquire (&chain[depth - 1]);
+  lock_release (&chain[depth - 1]);
+}
+
+static void
+run_donate (int depth) 
+{
+  static uint64_t acquire_samples[DONATE_ITERS];
+  char acquire_name[32], release_name[32];
+  struct bench acquire, release;
+  int i, j;
+
+  snprintf (acquire_name, sizeof acquire_name,
+            "donate.depth-%d.acquire", depth);
+  snprintf (release_name, sizeof release_name,
+            "donate.depth-%d.release", depth);
+  bench_init (&acquire, acquire_name, "cycles", acquire_samples,
+              DONATE_ITERS);
+  bench_init (&release, release_name, "cycles", samples, DONATE_ITERS);
+
+  for (i = 0; i < WARMUP + DONATE_ITERS; i++) 
+    {
+      uint64_t acquired, start;
+
+      /* Each thread preempts us, takes its own lock and blocks on
+         the previous one. */
+      lock_acquire (&chain[0]);
+      for (j = 1; j < depth; j++)
+        thread_create ("chain", PRI_DEFAULT + j, chain_thread,
+                       (void *) (intptr_t) j);
+      thread_create ("top", PRI_DEFAULT + depth, top_thread,
+                     (void *) (intptr_t) depth);
+      acquired = bench_cycles ();
+      if (thread_get_priority () != PRI_DEFAULT + depth)
+        fail ("priority %d after donation through %d locks, "
+              "expected %d", thread_get_priority (), depth,
+              PRI_DEFAULT + depth);
+
+      /* Every thread in the chain runs to completion before we
+         get the CPU back. */
+      start = bench_cycles ();
+      lock_release (&chain[0]);
+      if (i >= WARMUP) 
+        {
+          bench_add (&acquire, acquired - acquire_start);
+          bench_add (&release, bench_cycles () - start);
+        }
+    }
+  bench_report (&acquire);
+  bench_report (&release);
+}
+
+void
+test_bench_donate (void) 
+{
+  int depth;
+
+  ASSERT (!thread_mlfqs && !thread_cfs);
+
+  for (depth = 0; depth < DONATE_DEPTH_MAX; depth++)
+    lock_init (&chain[depth]);
+  for (depth = 1; depth <= DONATE_DEPTH_MAX; depth *= 2)
+    run_donate (depth);
+}
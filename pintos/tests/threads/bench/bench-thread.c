@@ -0,0 +1,85 @@
+/* Thread lifecycle microbenchmarks.
+
+   bench-create times thread_create() of a higher-priority
+   thread that returns at once, so each sample covers creating
+   the thread, switching to it, thread_exit() and switching
+   back.
+
+   bench-yield times thread_yield() ping-pong between the main
+   thread and another thread of the same priority.  Each sample
+   is one round trip, that is, two context switches. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "tests/threads/bench/bench.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+
+#define WARMUP 16
+#define ITERS 256
+
+static uint64_t samples[ITERS];
+
+static void
+exit_thread (void *aux UNUSED) 
+{
+}
+
+void
+test_bench_create (void) 
+{
+  struct bench b;
+  int i;
+
+  /* This test relies on strict priority preemption. */
+  ASSERT (!thread_mlfqs && !thread_cfs);
+
+  bench_init (&b, "create.exit", "cycles", samples, ITERS);
+  for (i = 0; i < WARMUP + ITERS; i++) 
+    {
+      uint64_t start = bench_cycles ();
+      thread_create ("bench", PRI_DEFAULT + 1, exit_thread, NULL);
+      if (i >= WARMUP)
+        bench_add (&b, bench_cycles () - start);
+    }
+  bench_report (&b);
+}
+
+static volatile bool yield_stop;
+
+static void
+yield_thread (void *done_) 
+{
+  struct semaphore *done = done_;
+
+  while (!yield_stop)
+    thread_yield ();
+  sema_up (done);
+}
+
+void
+test_bench_yield (void) 
+{
+  struct semaphore done;
+  struct bench b;
+  int i;
+
+  ASSERT (!thread_mlfqs && !thread_cfs);
+
+  sema_init (&done, 0);
+  yield_stop = false;
+  thread_create ("yielder", PRI_DEFAULT, yield_thread, &done);
+
+  bench_init (&b, "yield.round-trip", "cycles", samples, ITERS);
+  for (i = 0; i < WARMUP + ITERS; i++) 
+    {
+      uint64_t start = bench_cycles ();
+      thread_yield ();
+      if (i >= WARMUP)
+        bench_add (&b, bench_cycles () - start);
+    }
+  yield_stop = true;
+  sema_down (&done);
+  bench_report (&b);
+}
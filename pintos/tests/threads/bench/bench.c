@@ -0,0 +1,69 @@
+/* Common code for the microbenchmarks in this directory.
+
+   Each benchmark records one sample per iteration and then
+   prints a single line of the form
+
+     BENCH <metric> n=<N> min=<X> median=<X> mean=<X> max=<X> unit=<U>
+
+   followed, for cycle counts, by the mean converted to
+   nanoseconds.  "make bench" collects these lines into
+   bench.results, and tests/bench-compare compares two such
+   files. */
+
+#include "tests/threads/bench/bench.h"
+#include <debug.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Initializes B to record up to MAX samples of metric NAME,
+   measured in UNIT, into SAMPLES. */
+void
+bench_init (struct bench *b, const char *name, const char *unit,
+            uint64_t *samples, int max) 
+{
+  b->name = name;
+  b->unit = unit;
+  b->samples = samples;
+  b->cnt = 0;
+  b->max = max;
+}
+
+/* Records SAMPLE in B. */
+void
+bench_add (struct bench *b, uint64_t sample) 
+{
+  ASSERT (b->cnt < b->max);
+  b->samples[b->cnt++] = sample;
+}
+
+static int
+compare_samples (const void *a_, const void *b_) 
+{
+  const uint64_t *a = a_;
+  const uint64_t *b = b_;
+
+  return *a < *b ? -1 : *a > *b;
+}
+
+/* Prints the summary line for B.  Sorts B's samples. */
+void
+bench_report (struct bench *b) 
+{
+  uint64_t sum = 0, mean;
+  int i;
+
+  ASSERT (b->cnt > 0);
+  qsort (b->samples, b->cnt, sizeof *b->samples, compare_samples);
+  for (i = 0; i < b->cnt; i++)
+    sum += b->samples[i];
+  mean = sum / b->cnt;
+
+  printf ("BENCH %s n=%d min=%"PRIu64" median=%"PRIu64" mean=%"PRIu64
+          " max=%"PRIu64" unit=%s", b->name, b->cnt, b->samples[0],
+          b->samples[b->cnt / 2], mean, b->samples[b->cnt - 1], b->unit);
+  if (!strcmp (b->unit, "cycles"))
+    printf (" mean_ns=%"PRIu64, mean * 1000000 / (timer_cycles_hz () / 1000));
+  putchar ('\n');
+}
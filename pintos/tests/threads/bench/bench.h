@@ -0,0 +1,29 @@
+#ifndef TESTS_THREADS_BENCH_BENCH_H
+#define TESTS_THREADS_BENCH_BENCH_H
+
+#include <stdint.h>
+#include "devices/timer.h"
+
+/* Samples collected for one benchmark metric. */
+struct bench 
+  {
+    const char *name;           /* Metric name, e.g. "yield.round-trip". */
+    const char *unit;           /* "cycles" or "ns". */
+    uint64_t *samples;          /* Recorded samples. */
+    int cnt;                    /* Number of samples recorded. */
+    int max;                    /* Capacity of SAMPLES. */
+  };
+
+void bench_init (struct bench *, const char *name, const char *unit,
+                 uint64_t *samples, int max);
+void bench_add (struct bench *, uint64_t sample);
+void bench_report (struct bench *);
+
+/* Returns the current TSC value. */
+static inline uint64_t
+bench_cycles (void) 
+{
+  return timer_cycles ();
+}
+
+#endif /* tests/threads/bench/bench.h */
@@ -0,0 +1,83 @@
+/* Checks that the once-per-second MLFQS recomputation does work
+   proportional to the number of runnable threads, not to the
+   number of threads in the system, so that the time it spends
+   with interrupts off stays bounded as blocked threads pile up.
+
+   The main thread creates 100 threads that block on a semaphore,
+   then spins for 5 seconds.  After every second it checks that
+   the recomputation visited only the one runnable thread.
+   Finally it wakes the blocked threads, which must all run. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/malloc.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+
+#define THREAD_CNT 100
+
+struct block_info
+  {
+    struct semaphore go;        /* Upped once per blocked thread. */
+    struct semaphore done;      /* Upped by each thread on wake. */
+  };
+
+static void block_thread (void *info_);
+
+void
+test_mlfqs_block_many (void) 
+{
+  struct block_info info;
+  int64_t start_time;
+  int i;
+
+  ASSERT (thread_mlfqs);
+
+  sema_init (&info.go, 0);
+  sema_init (&info.done, 0);
+
+  msg ("Creating %d threads that block...", THREAD_CNT);
+  for (i = 0; i < THREAD_CNT; i++) 
+    {
+      char name[16];
+      snprintf (name, sizeof name, "block %d", i);
+      thread_create (name, PRI_DEFAULT, block_thread, &info);
+    }
+
+  /* Let every new thread run and block. */
+  timer_sleep (TIMER_FREQ);
+
+  msg ("Spinning for 5 seconds...");
+  for (i = 0; i < 5; i++) 
+    {
+      int visited;
+
+      start_time = timer_ticks ();
+      while (timer_elapsed (start_time) < TIMER_FREQ)
+        continue;
+
+      visited = thread_mlfqs_last_visited ();
+      if (visited > 1)
+        fail ("per-second update visited %d threads, "
+              "but only 1 thread is runnable", visited);
+    }
+  msg ("Per-second updates visited only the runnable thread.");
+
+  msg ("Waking up the blocked threads...");
+  for (i = 0; i < THREAD_CNT; i++)
+    sema_up (&info.go);
+  for (i = 0; i < THREAD_CNT; i++)
+    sema_down (&info.done);
+  msg ("All %d threads ran.", THREAD_CNT);
+}
+
+static void
+block_thread (void *info_) 
+{
+  struct block_info *info = info_;
+
+  sema_down (&info->go);
+  sema_up (&info->done);
+}
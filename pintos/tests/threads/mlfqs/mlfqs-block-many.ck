@@ -0,0 +1,14 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(mlfqs-block-many) begin
+(mlfqs-block-many) Creating 100 threads that block...
+(mlfqs-block-many) Spinning for 5 seconds...
+(mlfqs-block-many) Per-second updates visited only the runnable thread.
+(mlfqs-block-many) Waking up the blocked threads...
+(mlfqs-block-many) All 100 threads ran.
+(mlfqs-block-many) end
+EOF
+pass;
@@ -0,0 +1,67 @@
+/* The main thread acquires a readers-writer lock for reading.  A
+   higher-priority reader gets it at the same time without
+   blocking.  Then a writer blocks waiting for the main thread to
+   leave, donating its priority to the main thread, and a still
+   higher-priority reader queues up behind the writer, donating to
+   the writer and through it to the main thread.  When the main
+   thread releases the lock, the writer and then the last reader
+   should get it. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+
+static thread_func reader_thread_func;
+static thread_func writer_thread_func;
+
+void
+test_priority_donate_rwlock (void) 
+{
+  struct rwlock rwlock;
+
+  /* This test does not work with the MLFQS. */
+  ASSERT (!thread_mlfqs);
+
+  /* Make sure our priority is the default. */
+  ASSERT (thread_get_priority () == PRI_DEFAULT);
+
+  rwlock_init (&rwlock);
+  rwlock_read_acquire (&rwlock);
+  thread_create ("reader", PRI_DEFAULT + 1, reader_thread_func, &rwlock);
+  msg ("reader must already have finished.");
+  thread_create ("writer", PRI_DEFAULT + 2, writer_thread_func, &rwlock);
+  msg ("This thread should have priority %d.  Actual priority: %d.",
+       PRI_DEFAULT + 2, thread_get_priority ());
+  thread_create ("late-reader", PRI_DEFAULT + 3, reader_thread_func,
+                 &rwlock);
+  msg ("This thread should have priority %d.  Actual priority: %d.",
+       PRI_DEFAULT + 3, thread_get_priority ());
+  rwlock_read_release (&rwlock);
+  msg ("late-reader, writer must already have finished, in that order.");
+  msg ("This thread should have priority %d.  Actual priority: %d.",
+       PRI_DEFAULT, thread_get_priority ());
+}
+
+static void
+reader_thread_func (void *rwlock_) 
+{
+  struct rwlock *rwlock = rwlock_;
+
+  rwlock_read_acquire (rwlock);
+  msg ("%s: got the lock for reading", thread_name ());
+  rwlock_read_release (rwlock);
+  msg ("%s: done", thread_name ());
+}
+
+static void
+writer_thread_func (void *rwlock_) 
+{
+  struct rwlock *rwlock = rwlock_;
+
+  rwlock_write_acquire (rwlock);
+  msg ("writer: got the lock for writing");
+  rwlock_write_release (rwlock);
+  msg ("writer: done");
+}
@@ -0,0 +1,56 @@
+/* Checks the earliest-deadline-first real-time class: a
+   real-time thread runs ahead of a higher-priority normal thread
+   until it has used up its budget for the period, reservations
+   beyond the CPU's capacity are refused, and a thread's
+   reservation is released when it exits. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+
+#define MS 1000000LL
+
+static thread_func greedy_thread;
+static volatile bool greedy_done;
+
+void
+test_priority_edf (void) 
+{
+  int64_t start;
+
+  msg ("Reserving 60%% of the CPU.");
+  if (!thread_set_deadline (100 * MS, 60 * MS, 100 * MS))
+    fail ("60%% reservation refused.");
+
+  thread_create ("greedy", PRI_MAX, greedy_thread, NULL);
+  msg ("greedy must not have run yet.");
+
+  /* Spin until our budget runs out and greedy gets the CPU. */
+  start = timer_ticks ();
+  while (!greedy_done)
+    if (timer_elapsed (start) > 10 * TIMER_FREQ)
+      fail ("greedy never ran; main was not throttled.");
+  msg ("main: back after greedy.");
+
+  msg ("Reserving 90%% of the CPU.");
+  if (!thread_set_deadline (100 * MS, 90 * MS, 100 * MS))
+    fail ("greedy's reservation was not released when it exited.");
+  thread_set_deadline (0, 0, 0);
+  msg ("Left the real-time class.");
+}
+
+static void
+greedy_thread (void *aux UNUSED) 
+{
+  msg ("greedy: asking for 50%% of the CPU.");
+  if (thread_set_deadline (100 * MS, 50 * MS, 100 * MS))
+    fail ("admitted 110%% of the CPU.");
+  msg ("greedy: refused.");
+  msg ("greedy: asking for 30%% of the CPU.");
+  if (!thread_set_deadline (100 * MS, 30 * MS, 50 * MS))
+    fail ("30%% reservation refused.");
+  msg ("greedy: admitted.");
+  greedy_done = true;
+}
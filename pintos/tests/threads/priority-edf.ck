@@ -0,0 +1,18 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(priority-edf) begin
+(priority-edf) Reserving 60% of the CPU.
+(priority-edf) greedy must not have run yet.
+(priority-edf) greedy: asking for 50% of the CPU.
+(priority-edf) greedy: refused.
+(priority-edf) greedy: asking for 30% of the CPU.
+(priority-edf) greedy: admitted.
+(priority-edf) main: back after greedy.
+(priority-edf) Reserving 90% of the CPU.
+(priority-edf) Left the real-time class.
+(priority-edf) end
+EOF
+pass;
@@ -11,6 +11,11 @@ extern test_func test_alarm_simultaneous;
 extern test_func test_alarm_priority;
 extern test_func test_alarm_zero;
 extern test_func test_alarm_negative;
+extern test_func test_alarm_long;
+extern test_func test_alarm_cancel;
+extern test_func test_alarm_nohz;
+extern test_func test_alarm_usleep;
+extern test_func test_workqueue_order;
 extern test_func test_priority_change;
 extern test_func test_priority_donate_one;
 extern test_func test_priority_donate_multiple;
@@ -19,10 +24,12 @@ extern test_func test_priority_donate_sema;
 extern test_func test_priority_donate_nest;
 extern test_func test_priority_donate_lower;
 extern test_func test_priority_donate_chain;
+extern test_func test_priority_donate_rwlock;
 extern test_func test_priority_fifo;
 extern test_func test_priority_preempt;
 extern test_func test_priority_sema;
 extern test_func test_priority_condvar;
+extern test_func test_priority_edf;
 extern test_func test_mlfqs_load_1;
 extern test_func test_mlfqs_load_60;
 extern test_func test_mlfqs_load_avg;
@@ -32,6 +39,20 @@ extern test_func test_mlfqs_fair_20;
 extern test_func test_mlfqs_nice_2;
 extern test_func test_mlfqs_nice_10;
 extern test_func test_mlfqs_block;
+extern test_func test_mlfqs_block_many;
+extern test_func test_cfs_fair_2;
+extern test_func test_cfs_fair_20;
+extern test_func test_cfs_nice_2;
+extern test_func test_cfs_nice_10;
+extern test_func test_adaptive_mix_base;
+extern test_func test_adaptive_mix;
+extern test_func test_bench_create;
+extern test_func test_bench_yield;
+extern test_func test_bench_sema;
+extern test_func test_bench_lock;
+extern test_func test_bench_condvar;
+extern test_func test_bench_donate;
+extern test_func test_bench_sleep;
 
 void msg (const char *, ...);
 void fail (const char *, ...);
@@ -0,0 +1,77 @@
+/* Queues work from a timer callback, which runs in interrupt
+   context, and checks that each item runs in a worker thread
+   outside interrupt context, where it may sleep, and that the
+   items run in the order they were queued. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/interrupt.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "threads/workqueue.h"
+#include "devices/timer.h"
+
+#define WORK_CNT 8
+
+static struct work works[WORK_CNT];
+static int order[WORK_CNT];
+static int ran_cnt;
+static bool queued_in_intr;
+static bool ran_in_intr;
+static struct semaphore done;
+
+/* Records that work item IDX_ ran.  The first item sleeps, so
+   the others can only run after it if they run in order. */
+static void
+record_work (void *idx_) 
+{
+  int idx = (int) (intptr_t) idx_;
+
+  if (intr_context ())
+    ran_in_intr = true;
+  if (idx == 0)
+    timer_msleep (20);
+  order[ran_cnt++] = idx;
+  if (ran_cnt == WORK_CNT)
+    sema_up (&done);
+}
+
+/* Timer callback: queues every work item. */
+static void
+queue_works (void *aux UNUSED) 
+{
+  int i;
+
+  queued_in_intr = intr_context ();
+  for (i = 0; i < WORK_CNT; i++)
+    workqueue_submit (&works[i]);
+}
+
+void
+test_workqueue_order (void) 
+{
+  struct timer t;
+  int i;
+
+  sema_init (&done, 0);
+  for (i = 0; i < WORK_CNT; i++)
+    work_init (&works[i], record_work, (void *) (intptr_t) i);
+
+  msg ("Queueing %d work items from a timer callback.", WORK_CNT);
+  timer_setup (&t, queue_works, NULL);
+  timer_add (&t, timer_ticks () + 5);
+  sema_down (&done);
+
+  if (!queued_in_intr)
+    fail ("timer callback did not run in interrupt context");
+  if (ran_in_intr)
+    fail ("work ran in interrupt context");
+  msg ("All work ran outside interrupt context.");
+
+  for (i = 0; i < WORK_CNT; i++)
+    if (order[i] != i)
+      fail ("work item %d ran in position %d", order[i], i);
+  msg ("Work ran in the order queued.");
+}
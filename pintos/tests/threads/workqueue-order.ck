@@ -0,0 +1,12 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(workqueue-order) begin
+(workqueue-order) Queueing 8 work items from a timer callback.
+(workqueue-order) All work ran outside interrupt context.
+(workqueue-order) Work ran in the order queued.
+(workqueue-order) end
+EOF
+pass;
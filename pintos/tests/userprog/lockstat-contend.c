@@ -0,0 +1,78 @@
+/* Has a parent and its child write files at the same time, so
+   that each waits for filesys_lock while the other holds it for
+   disk I/O, and checks with lockstat() that the lock's
+   acquisition, contention and wait counters went up.  Run with
+   -lockstat. */
+
+#include <lock-stat.h>
+#include <string.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define STAT_MAX 256
+#define WRITE_CNT 50
+
+static struct lock_stat stats[STAT_MAX];
+static char buf[4096];
+
+/* Returns a copy of the filesys_lock record. */
+static struct lock_stat
+filesys_lock_stat (void) 
+{
+  int n = lockstat (stats, STAT_MAX);
+  int i;
+
+  for (i = 0; i < n; i++)
+    if (!strcmp (stats[i].name, "filesys_lock"))
+      return stats[i];
+  fail ("no filesys_lock record among %d", n);
+}
+
+/* Rewrites the start of FILE WRITE_CNT times. */
+static void
+write_file (const char *file) 
+{
+  int fd = open (file);
+  int i;
+
+  if (fd < 2)
+    fail ("open \"%s\"", file);
+  for (i = 0; i < WRITE_CNT; i++) 
+    {
+      seek (fd, 0);
+      if (write (fd, buf, sizeof buf) != sizeof buf)
+        fail ("write \"%s\"", file);
+    }
+  close (fd);
+}
+
+void
+test_main (void) 
+{
+  struct lock_stat before, after;
+  int pid;
+
+  CHECK (create ("a", sizeof buf), "create \"a\"");
+  CHECK (create ("b", sizeof buf), "create \"b\"");
+  before = filesys_lock_stat ();
+
+  if ((pid = fork ("child")) == 0)
+    {
+      write_file ("b");
+      exit (0);
+    }
+  write_file ("a");
+  msg ("wrote \"a\" while the child wrote \"b\"");
+  CHECK (wait (pid) == 0, "wait for child");
+
+  after = filesys_lock_stat ();
+  if (after.acquired < before.acquired + 2 * WRITE_CNT)
+    fail ("filesys_lock acquired only %llu more times",
+          (unsigned long long) (after.acquired - before.acquired));
+  if (after.contended <= before.contended)
+    fail ("filesys_lock contention did not go up");
+  if (after.wait_ns <= before.wait_ns || after.wait_max_ns == 0)
+    fail ("filesys_lock wait time did not go up");
+  msg ("filesys_lock contention and wait time went up");
+}
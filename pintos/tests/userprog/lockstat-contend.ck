@@ -0,0 +1,14 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(lockstat-contend) begin
+(lockstat-contend) create "a"
+(lockstat-contend) create "b"
+(lockstat-contend) wrote "a" while the child wrote "b"
+(lockstat-contend) wait for child
+(lockstat-contend) filesys_lock contention and wait time went up
+(lockstat-contend) end
+EOF
+pass;
@@ -0,0 +1,72 @@
+/* Starts several threads that add to a shared counter under a
+   mutex, joins them, and checks the total and their return
+   values.  Then checks that a condition variable hands a value
+   from one thread to another. */
+
+#include <pthread.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define THREAD_CNT 4
+#define ITER_CNT 2000
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static int counter;
+static int mailbox;
+
+static void *
+adder (void *aux) 
+{
+  int id = (int) (long) aux;
+  int i;
+
+  for (i = 0; i < ITER_CNT; i++)
+    {
+      pthread_mutex_lock (&lock);
+      counter++;
+      pthread_mutex_unlock (&lock);
+    }
+  return (void *) (long) (id * 10);
+}
+
+static void *
+sender (void *aux UNUSED) 
+{
+  pthread_mutex_lock (&lock);
+  mailbox = 42;
+  pthread_cond_signal (&cond);
+  pthread_mutex_unlock (&lock);
+  return NULL;
+}
+
+void
+test_main (void) 
+{
+  pthread_t threads[THREAD_CNT];
+  pthread_t t;
+  void *retval;
+  int i;
+
+  for (i = 0; i < THREAD_CNT; i++)
+    CHECK (pthread_create (&threads[i], adder, (void *) (long) i) == 0,
+           "create thread %d", i);
+  for (i = 0; i < THREAD_CNT; i++)
+    {
+      CHECK (pthread_join (threads[i], &retval) == 0, "join thread %d", i);
+      if ((long) retval != i * 10)
+        fail ("thread %d returned %ld, expected %d", i, (long) retval, i * 10);
+    }
+  if (counter != THREAD_CNT * ITER_CNT)
+    fail ("counter is %d, expected %d", counter, THREAD_CNT * ITER_CNT);
+  msg ("counter is %d", counter);
+
+  pthread_mutex_lock (&lock);
+  CHECK (pthread_create (&t, sender, NULL) == 0, "create sender");
+  while (mailbox == 0)
+    pthread_cond_wait (&cond, &lock);
+  pthread_mutex_unlock (&lock);
+  pthread_join (t, NULL);
+  msg ("received %d", mailbox);
+}
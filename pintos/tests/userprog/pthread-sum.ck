@@ -0,0 +1,21 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(pthread-sum) begin
+(pthread-sum) create thread 0
+(pthread-sum) create thread 1
+(pthread-sum) create thread 2
+(pthread-sum) create thread 3
+(pthread-sum) join thread 0
+(pthread-sum) join thread 1
+(pthread-sum) join thread 2
+(pthread-sum) join thread 3
+(pthread-sum) counter is 8000
+(pthread-sum) create sender
+(pthread-sum) received 42
+(pthread-sum) end
+pthread-sum: exit(0)
+EOF
+pass;
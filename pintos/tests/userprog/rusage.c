@@ -0,0 +1,60 @@
+/* Checks that getrusage() reports user time that grows while the
+   process computes, and that a waited-for child's usage is added
+   to RUSAGE_CHILDREN. */
+
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+/* Burns user CPU time until at least NS nanoseconds of it have
+   been charged to the calling process. */
+static void
+spin (uint64_t ns) 
+{
+  struct rusage ru;
+  uint64_t start;
+
+  getrusage (RUSAGE_SELF, &ru);
+  start = ru.utime_ns;
+  do
+    {
+      volatile int i;
+      for (i = 0; i < 100000; i++)
+        continue;
+      getrusage (RUSAGE_SELF, &ru);
+    }
+  while (ru.utime_ns - start < ns);
+}
+
+void
+test_main (void) 
+{
+  struct rusage self, thread, children;
+  int pid;
+
+  CHECK (getrusage (RUSAGE_SELF, &self) == 0, "getrusage (RUSAGE_SELF)");
+  CHECK (getrusage (RUSAGE_THREAD, &thread) == 0, "getrusage (RUSAGE_THREAD)");
+  CHECK (getrusage (12345, &self) == -1, "getrusage with bad who fails");
+
+  spin (20 * 1000 * 1000);
+  msg ("spun for 20 ms of user time");
+
+  CHECK (getrusage (RUSAGE_CHILDREN, &children) == 0,
+         "getrusage (RUSAGE_CHILDREN)");
+  if (children.utime_ns != 0)
+    fail ("children used %llu ns before any child existed",
+          (unsigned long long) children.utime_ns);
+
+  if ((pid = fork ("child")) == 0)
+    {
+      spin (20 * 1000 * 1000);
+      exit (0);
+    }
+  CHECK (wait (pid) == 0, "wait for child");
+
+  getrusage (RUSAGE_CHILDREN, &children);
+  if (children.utime_ns < 20 * 1000 * 1000)
+    fail ("children used only %llu ns of user time",
+          (unsigned long long) children.utime_ns);
+  msg ("child's user time added to RUSAGE_CHILDREN");
+}
@@ -0,0 +1,18 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(rusage) begin
+(rusage) getrusage (RUSAGE_SELF)
+(rusage) getrusage (RUSAGE_THREAD)
+(rusage) getrusage with bad who fails
+(rusage) spun for 20 ms of user time
+(rusage) getrusage (RUSAGE_CHILDREN)
+(rusage) wait for child
+child: exit(0)
+(rusage) child's user time added to RUSAGE_CHILDREN
+(rusage) end
+rusage: exit(0)
+EOF
+pass;
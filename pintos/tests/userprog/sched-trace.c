@@ -0,0 +1,133 @@
+/* Reads the scheduler trace with sched_trace() after running
+   next to a CPU-bound child and then waiting for it.  Checks that
+   the events are well formed and in time order, that waiting
+   shows up as a block followed by a wakeup and a switch back in,
+   and that both histograms gained samples. */
+
+#include <sched-trace.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define EVENT_MAX 512
+
+static struct sched_event events[EVENT_MAX];
+static struct sched_hist before, after;
+
+/* Burns user CPU time until at least NS nanoseconds of it have
+   been charged to the calling process. */
+static void
+spin (uint64_t ns) 
+{
+  struct rusage ru;
+  uint64_t start;
+
+  getrusage (RUSAGE_SELF, &ru);
+  start = ru.utime_ns;
+  do
+    {
+      volatile int i;
+      for (i = 0; i < 100000; i++)
+        continue;
+      getrusage (RUSAGE_SELF, &ru);
+    }
+  while (ru.utime_ns - start < ns);
+}
+
+/* Returns the number of samples in HIST. */
+static uint64_t
+hist_sum (const uint64_t hist[SCHED_HIST_BUCKETS]) 
+{
+  uint64_t sum = 0;
+  int i;
+
+  for (i = 0; i < SCHED_HIST_BUCKETS; i++)
+    sum += hist[i];
+  return sum;
+}
+
+/* Checks that each of the N events in EVENTS is well formed, that
+   events from one CPU are in time order, and that every switch
+   out is paired with the switch in that replaced it. */
+static void
+check_events (int n) 
+{
+  int i;
+
+  for (i = 0; i < n; i++) 
+    {
+      const struct sched_event *e = &events[i];
+
+      if (e->type >= SCHED_EV_CNT)
+        fail ("event %d has bad type %d", i, e->type);
+      if (e->tid <= 0)
+        fail ("event %d has bad tid %d", i, e->tid);
+      if (i > 0 && e->cpu == e[-1].cpu && e->ts < e[-1].ts)
+        fail ("event %d at %llu ns is older than the one before it", i,
+              (unsigned long long) e->ts);
+      if (e->type == SCHED_EV_BLOCK && e->arg > SCHED_BLOCK_RWLOCK)
+        fail ("block event %d has bad reason %d", i, e->arg);
+      if (e->type == SCHED_EV_SWITCH_OUT
+          && (i + 1 >= n || e[1].type != SCHED_EV_SWITCH_IN
+              || e[1].ts != e->ts || e[1].cpu != e->cpu))
+        fail ("switch out at event %d has no matching switch in", i);
+    }
+}
+
+/* Returns true if some thread that blocked in the first N
+   EVENTS was then woken and later switched back in. */
+static bool
+block_then_run (int n) 
+{
+  int block, i;
+
+  for (block = 0; block < n; block++) 
+    {
+      bool woken = false;
+
+      if (events[block].type != SCHED_EV_BLOCK)
+        continue;
+      for (i = block + 1; i < n; i++)
+        if (events[i].tid == events[block].tid) 
+          {
+            if (events[i].type == SCHED_EV_WAKEUP)
+              woken = true;
+            else if (woken && events[i].type == SCHED_EV_SWITCH_IN)
+              return true;
+          }
+    }
+  return false;
+}
+
+void
+test_main (void) 
+{
+  int pid, n;
+
+  CHECK (sched_trace (events, 0, &before) == 0,
+         "sched_trace with no room for events");
+
+  if ((pid = fork ("child")) == 0)
+    {
+      spin (60 * 1000 * 1000);
+      exit (0);
+    }
+  spin (30 * 1000 * 1000);
+  msg ("spun next to a CPU-bound child");
+  CHECK (wait (pid) == 0, "wait for child");
+
+  n = sched_trace (events, EVENT_MAX, &after);
+  CHECK (n > 0 && n <= EVENT_MAX, "sched_trace");
+  check_events (n);
+  msg ("events are well formed and in order");
+
+  if (!block_then_run (n))
+    fail ("no block followed by a wakeup and a switch in");
+  msg ("blocked thread was woken and ran again");
+
+  if (hist_sum (after.wakeup_latency) <= hist_sum (before.wakeup_latency))
+    fail ("wakeup latency histogram has no new samples");
+  if (hist_sum (after.slice) <= hist_sum (before.slice))
+    fail ("time slice histogram has no new samples");
+  msg ("histograms gained samples");
+}
@@ -0,0 +1,16 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(sched-trace) begin
+(sched-trace) sched_trace with no room for events
+(sched-trace) spun next to a CPU-bound child
+(sched-trace) wait for child
+(sched-trace) sched_trace
+(sched-trace) events are well formed and in order
+(sched-trace) blocked thread was woken and ran again
+(sched-trace) histograms gained samples
+(sched-trace) end
+EOF
+pass;
@@ -0,0 +1,70 @@
+/* Fills more anonymous memory than fits in RAM, so that the first
+   pages are in swap, then forks.  The parent and the child each
+   write their own stamp to every page and must keep seeing only
+   their own, both in pages that were swapped out at the fork and
+   in pages that were in memory.
+   For this test, Pintos memory size is 10MB. */
+
+#include <string.h>
+#include <syscall.h>
+#include <stdint.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define CHUNK_SIZE (16 * 1024 * 1024)
+#define PAGE_COUNT (CHUNK_SIZE / PAGE_SIZE)
+
+static char chunk[CHUNK_SIZE];
+
+/* Stamps the first and last byte of every page with its index
+   plus DELTA. */
+static void
+stamp (int delta)
+{
+  size_t i;
+
+  for (i = 0; i < PAGE_COUNT; i++)
+    {
+      chunk[i * PAGE_SIZE] = (char) (i + delta);
+      chunk[i * PAGE_SIZE + PAGE_SIZE - 1] = (char) (i + delta);
+    }
+}
+
+/* Fails unless every page carries the stamp written by
+   stamp (DELTA). */
+static void
+check_stamp (const char *who, int delta)
+{
+  size_t i;
+
+  for (i = 0; i < PAGE_COUNT; i++)
+    if (chunk[i * PAGE_SIZE] != (char) (i + delta)
+        || chunk[i * PAGE_SIZE + PAGE_SIZE - 1] != (char) (i + delta))
+      fail ("%s: page %zu is inconsistent", who, i);
+}
+
+void
+test_main (void)
+{
+  pid_t child;
+
+  stamp (0);
+  msg ("filled %d pages", PAGE_COUNT);
+
+  child = fork ("child");
+  if (child == 0)
+    {
+      check_stamp ("child", 0);
+      msg ("child sees the data from before fork");
+      stamp (1);
+      check_stamp ("child", 1);
+      msg ("child sees its own writes");
+      return;
+    }
+
+  stamp (2);
+  CHECK (wait (child) == 0, "wait for child");
+  check_stamp ("parent", 2);
+  msg ("parent sees its own writes");
+}
@@ -0,0 +1,15 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(cow-swap) begin
+(cow-swap) filled 4096 pages
+(cow-swap) child sees the data from before fork
+(cow-swap) child sees its own writes
+(cow-swap) end
+(cow-swap) wait for child
+(cow-swap) parent sees its own writes
+(cow-swap) end
+EOF
+pass;
@@ -0,0 +1,47 @@
+/* Forks while an anonymous page holds known data, then has the
+   parent and the child each write their own pattern to it.  Each
+   must keep seeing only its own data. */
+
+#include <string.h>
+#include <syscall.h>
+#include <stdbool.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+
+static char page[PAGE_SIZE] __attribute__ ((aligned (PAGE_SIZE)));
+
+/* Returns true if every byte of PAGE is C. */
+static bool
+page_is (char c)
+{
+  size_t i;
+
+  for (i = 0; i < PAGE_SIZE; i++)
+    if (page[i] != c)
+      return false;
+  return true;
+}
+
+void
+test_main (void)
+{
+  pid_t child;
+
+  memset (page, 'o', PAGE_SIZE);
+
+  child = fork ("child");
+  if (child == 0)
+    {
+      CHECK (page_is ('o'), "child sees the data from before fork");
+      memset (page, 'c', PAGE_SIZE);
+      CHECK (page_is ('c'), "child sees its own write");
+      return;
+    }
+
+  /* 자식이 검사하기 전이든 후든 부모의 쓰기는 보이면 안 된다 */
+  memset (page, 'p', PAGE_SIZE);
+  CHECK (wait (child) == 0, "wait for child");
+  CHECK (page_is ('p'), "parent sees its own write");
+}
@@ -0,0 +1,14 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(cow-write) begin
+(cow-write) child sees the data from before fork
+(cow-write) child sees its own write
+(cow-write) end
+(cow-write) wait for child
+(cow-write) parent sees its own write
+(cow-write) end
+EOF
+pass;
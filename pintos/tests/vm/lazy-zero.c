@@ -0,0 +1,46 @@
+/* Reads a 32MB uninitialized array, three times more than fits in
+   RAM, and checks that it is all zeros.  Untouched anonymous pages
+   read as the shared zero frame, so this must neither run out of
+   frames nor push anything to swap.  Then writes one page and
+   checks that only that page changed.
+   For this test, Pintos memory size is 10MB. */
+
+#include <string.h>
+#include <stdint.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define CHUNK_SIZE (32 * 1024 * 1024)
+#define PAGE_COUNT (CHUNK_SIZE / PAGE_SIZE)
+#define WORDS_PER_PAGE (PAGE_SIZE / sizeof (uint64_t))
+#define WRITTEN_PAGE (PAGE_COUNT / 2)
+
+static uint64_t chunk[PAGE_COUNT][WORDS_PER_PAGE];
+
+/* Fails unless every word of page I equals VALUE. */
+static void
+check_page (size_t i, uint64_t value)
+{
+  size_t j;
+
+  for (j = 0; j < WORDS_PER_PAGE; j++)
+    if (chunk[i][j] != value)
+      fail ("word %zu of page %zu is inconsistent", j, i);
+}
+
+void
+test_main (void)
+{
+  size_t i;
+
+  for (i = 0; i < PAGE_COUNT; i++)
+    check_page (i, 0);
+  msg ("read %d zero pages", PAGE_COUNT);
+
+  memset (chunk[WRITTEN_PAGE], 0xcc, PAGE_SIZE);
+  for (i = 0; i < PAGE_COUNT; i++)
+    check_page (i, i == WRITTEN_PAGE ? 0xcccccccccccccccc : 0);
+  msg ("only the written page changed");
+}
@@ -0,0 +1,20 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(lazy-zero) begin
+(lazy-zero) read 8192 zero pages
+(lazy-zero) only the written page changed
+(lazy-zero) end
+EOF
+
+# Every page of the array must have been read through the zero
+# frame, not given a frame of its own.
+our ($test);
+my (@output) = read_text_file ("$test.output");
+my ($stats) = grep (/^VM: \d+ zero-page maps/, @output);
+fail "missing zero-page statistics\n" if !defined $stats;
+my ($maps) = $stats =~ /^VM: (\d+) zero-page maps/;
+fail "only $maps zero-page maps\n" if $maps < 8192;
+pass;
@@ -0,0 +1,55 @@
+/* Maps "large.txt" read-only at MAP_CNT addresses, more than fits
+   in memory at once, and reads every mapping through twice.  The
+   working set is almost all clean file pages, so eviction should
+   drop them instead of writing anything to swap; the .ck file
+   checks that against the kernel's eviction and swap statistics.
+   For this test, Pintos memory size is 10MB. */
+
+#include <string.h>
+#include <syscall.h>
+#include <stdint.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define MAP_CNT 4
+#define MAP_BASE ((char *) 0x10000000)
+#define MAP_STRIDE (4 * 1024 * 1024)
+#define PASS_CNT 2
+
+/* Returns a checksum of the SIZE bytes at BUF. */
+static uint32_t
+checksum (const char *buf, size_t size) 
+{
+  uint32_t sum = 0;
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    sum = sum * 31 + (unsigned char) buf[i];
+  return sum;
+}
+
+void
+test_main (void) 
+{
+  uint32_t sums[MAP_CNT];
+  size_t size;
+  int handle, pass, i;
+
+  CHECK ((handle = open ("large.txt")) > 1, "open \"large.txt\"");
+  size = filesize (handle);
+  for (i = 0; i < MAP_CNT; i++)
+    if (mmap (MAP_BASE + i * MAP_STRIDE, size, 0, handle, 0) == MAP_FAILED)
+      fail ("mmap \"large.txt\" #%d", i);
+  msg ("mapped \"large.txt\" %d times", MAP_CNT);
+
+  for (pass = 0; pass < PASS_CNT; pass++)
+    for (i = 0; i < MAP_CNT; i++) 
+      {
+        uint32_t sum = checksum (MAP_BASE + i * MAP_STRIDE, size);
+        if (pass == 0 && i == 0)
+          sums[0] = sum;
+        if (sum != sums[0])
+          fail ("pass %d read different data from mapping %d", pass, i);
+      }
+  msg ("read every mapping %d times", PASS_CNT);
+}
@@ -0,0 +1,33 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(swap-clean) begin
+(swap-clean) open "large.txt"
+(swap-clean) mapped "large.txt" 4 times
+(swap-clean) read every mapping 2 times
+(swap-clean) end
+EOF
+
+# Reading 8 MB of clean file pages through about 4 MB of user
+# frames must evict them over and over.  The clock should pick
+# clean pages and drop them, so only the few anonymous pages of
+# the program itself may ever be written to swap.
+our ($test);
+my (@output) = read_text_file ("$test.output");
+my ($vm) = grep (/^VM: \d+ evictions/, @output);
+my ($swap) = grep (/^Swap: \d+ pages out/, @output);
+fail "missing VM statistics\n" if !defined $vm;
+fail "missing swap statistics\n" if !defined $swap;
+my ($evictions, $clean, $chances)
+  = $vm =~ /(\d+) evictions \((\d+) clean\), \d+ frames scanned, (\d+) second/;
+my ($out) = $swap =~ /(\d+) pages out/;
+
+fail "only $evictions evictions\n" if $evictions < 1000;
+fail "only $clean of $evictions evictions were clean\n"
+  if ($evictions - $clean) * 50 > $evictions;
+fail "$out pages written to swap for $evictions evictions\n"
+  if $out * 50 > $evictions;
+fail "clock gave no second chances\n" if $chances == 0;
+pass;
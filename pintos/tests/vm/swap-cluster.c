@@ -0,0 +1,69 @@
+/* Fills more anonymous memory than fits in RAM, so that pages go
+   out to swap many clusters at a time, then reads them back in the
+   opposite order and checks every word of every page.  A page
+   read or written with the wrong sector count or at the wrong
+   offset within its cluster shows up as a bad word.  Finally
+   rewrites every other page and checks everything again, so that
+   new clusters are carved out of a swap disk with holes in it.
+   For this test, Pintos memory size is 10MB. */
+
+#include <string.h>
+#include <stdint.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define CHUNK_SIZE (12 * 1024 * 1024)
+#define PAGE_COUNT (CHUNK_SIZE / PAGE_SIZE)
+#define WORDS_PER_PAGE (PAGE_SIZE / sizeof (uint64_t))
+
+static uint64_t chunk[PAGE_COUNT][WORDS_PER_PAGE];
+
+/* Word J of page I after GEN rounds of writes. */
+static uint64_t
+word (size_t i, size_t j, int gen)
+{
+  return ((uint64_t) gen << 48) | ((uint64_t) i << 16) | j;
+}
+
+/* Writes generation GEN to page I. */
+static void
+fill_page (size_t i, int gen)
+{
+  size_t j;
+
+  for (j = 0; j < WORDS_PER_PAGE; j++)
+    chunk[i][j] = word (i, j, gen);
+}
+
+/* Fails unless page I holds generation GEN. */
+static void
+check_page (size_t i, int gen)
+{
+  size_t j;
+
+  for (j = 0; j < WORDS_PER_PAGE; j++)
+    if (chunk[i][j] != word (i, j, gen))
+      fail ("word %zu of page %zu is inconsistent", j, i);
+}
+
+void
+test_main (void)
+{
+  size_t i;
+
+  for (i = 0; i < PAGE_COUNT; i++)
+    fill_page (i, 0);
+  msg ("filled %d pages", PAGE_COUNT);
+
+  for (i = PAGE_COUNT; i-- > 0; )
+    check_page (i, 0);
+  msg ("read back in reverse order");
+
+  for (i = 0; i < PAGE_COUNT; i += 2)
+    fill_page (i, 1);
+  for (i = 0; i < PAGE_COUNT; i++)
+    check_page (i, i % 2 == 0);
+  msg ("rewrote every other page");
+}
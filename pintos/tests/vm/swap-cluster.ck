@@ -0,0 +1,20 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(swap-cluster) begin
+(swap-cluster) filled 3072 pages
+(swap-cluster) read back in reverse order
+(swap-cluster) rewrote every other page
+(swap-cluster) end
+EOF
+
+# Pages must have gone out in more than one cluster.
+our ($test);
+my (@output) = read_text_file ("$test.output");
+my ($stats) = grep (/^Swap: \d+ pages out/, @output);
+fail "missing swap statistics\n" if !defined $stats;
+my ($clusters) = $stats =~ /(\d+) clusters/;
+fail "only $clusters swap clusters used\n" if $clusters < 2;
+pass;
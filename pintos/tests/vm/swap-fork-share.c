@@ -0,0 +1,88 @@
+/* Fills more anonymous memory than fits in RAM, so that most pages
+   are in swap, then forks two children in turn.  Forking shares
+   each swapped-out slot between parent and child instead of
+   copying it.  The first child rewrites half of the pages; the
+   second only reads.  The parent must keep its own data after
+   each child exits, which fails if a child's exit or write drops
+   a slot the parent still refers to.
+   For this test, Pintos memory size is 10MB. */
+
+#include <string.h>
+#include <syscall.h>
+#include <stdint.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define CHUNK_SIZE (12 * 1024 * 1024)
+#define PAGE_COUNT (CHUNK_SIZE / PAGE_SIZE)
+
+static char chunk[CHUNK_SIZE];
+
+/* Stamps the first and last byte of every STRIDE'th page with its
+   index plus DELTA. */
+static void
+stamp (size_t stride, int delta)
+{
+  size_t i;
+
+  for (i = 0; i < PAGE_COUNT; i += stride)
+    {
+      chunk[i * PAGE_SIZE] = (char) (i + delta);
+      chunk[i * PAGE_SIZE + PAGE_SIZE - 1] = (char) (i + delta);
+    }
+}
+
+/* Fails unless page I carries the stamp written with DELTA. */
+static void
+check_page (const char *who, size_t i, int delta)
+{
+  if (chunk[i * PAGE_SIZE] != (char) (i + delta)
+      || chunk[i * PAGE_SIZE + PAGE_SIZE - 1] != (char) (i + delta))
+    fail ("%s: page %zu is inconsistent", who, i);
+}
+
+/* Fails unless every page carries the stamp written with DELTA. */
+static void
+check_stamp (const char *who, int delta)
+{
+  size_t i;
+
+  for (i = 0; i < PAGE_COUNT; i++)
+    check_page (who, i, delta);
+}
+
+void
+test_main (void)
+{
+  pid_t child;
+  size_t i;
+
+  stamp (1, 0);
+  msg ("filled %d pages", PAGE_COUNT);
+
+  child = fork ("writer");
+  if (child == 0)
+    {
+      check_stamp ("writer", 0);
+      stamp (2, 1);
+      for (i = 0; i < PAGE_COUNT; i++)
+        check_page ("writer", i, i % 2 == 0);
+      msg ("writer sees its own writes");
+      return;
+    }
+  CHECK (wait (child) == 0, "wait for writer");
+  check_stamp ("parent", 0);
+  msg ("parent data intact after writer");
+
+  child = fork ("reader");
+  if (child == 0)
+    {
+      check_stamp ("reader", 0);
+      msg ("reader sees the parent's data");
+      return;
+    }
+  CHECK (wait (child) == 0, "wait for reader");
+  check_stamp ("parent", 0);
+  msg ("parent data intact after reader");
+}
@@ -0,0 +1,18 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(swap-fork-share) begin
+(swap-fork-share) filled 3072 pages
+(swap-fork-share) writer sees its own writes
+(swap-fork-share) end
+(swap-fork-share) wait for writer
+(swap-fork-share) parent data intact after writer
+(swap-fork-share) reader sees the parent's data
+(swap-fork-share) end
+(swap-fork-share) wait for reader
+(swap-fork-share) parent data intact after reader
+(swap-fork-share) end
+EOF
+pass;
@@ -0,0 +1,40 @@
+/* Fills twice as much anonymous memory as fits in RAM, so that free
+   frames drop below the reclaim thread's low watermark over and
+   over, then checks every byte of every page.  Pages the reclaim
+   thread swapped out in the background must read back intact.
+   For this test, Pintos memory size is 10MB. */
+
+#include <string.h>
+#include <stdint.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define CHUNK_SIZE (16 * 1024 * 1024)
+#define PAGE_COUNT (CHUNK_SIZE / PAGE_SIZE)
+
+static char chunk[CHUNK_SIZE];
+
+/* Byte that fills page I. */
+static char
+page_byte (size_t i)
+{
+  return (char) (i * 7 + 1);
+}
+
+void
+test_main (void)
+{
+  size_t i, j;
+
+  for (i = 0; i < PAGE_COUNT; i++)
+    memset (chunk + i * PAGE_SIZE, page_byte (i), PAGE_SIZE);
+  msg ("filled %d pages", PAGE_COUNT);
+
+  for (i = 0; i < PAGE_COUNT; i++)
+    for (j = 0; j < PAGE_SIZE; j++)
+      if (chunk[i * PAGE_SIZE + j] != page_byte (i))
+        fail ("byte %zu of page %zu is inconsistent", j, i);
+  msg ("all pages read back");
+}
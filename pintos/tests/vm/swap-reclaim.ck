@@ -0,0 +1,22 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(swap-reclaim) begin
+(swap-reclaim) filled 4096 pages
+(swap-reclaim) all pages read back
+(swap-reclaim) end
+EOF
+
+# The reclaim thread must have run, and no fault may have gone
+# without a frame.
+our ($test);
+my (@output) = read_text_file ("$test.output");
+my ($stats) = grep (/^VM: \d+ reclaim wakeups/, @output);
+fail "missing reclaim statistics\n" if !defined $stats;
+my ($wakeups, $failed)
+  = $stats =~ /^VM: (\d+) reclaim wakeups, .* (\d+) failed/;
+fail "reclaim thread never woke\n" if !$wakeups;
+fail "$failed faults found no frame\n" if $failed;
+pass;
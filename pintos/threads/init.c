@@ -14,13 +14,17 @@
 #include "devices/timer.h"
 #include "devices/vga.h"
 #include "threads/interrupt.h"
+#include "threads/lockstat.h"
 #include "threads/io.h"
 #include "threads/loader.h"
 #include "threads/malloc.h"
 #include "threads/mmu.h"
 #include "threads/palloc.h"
+#include "threads/profile.h"
 #include "threads/pte.h"
 #include "threads/thread.h"
+#include "threads/trace.h"
+#include "threads/workqueue.h"
 #ifdef USERPROG
 #include "userprog/process.h"
 #include "userprog/exception.h"
@@ -103,6 +107,7 @@ main (void) {
 #endif
 	/* Start thread scheduler and enable interrupts. */
 	thread_start ();
+	workqueue_init ();
 	serial_init_queue ();
 	timer_calibrate ();
 
@@ -221,15 +226,35 @@ parse_options (char **argv) {
 			random_init (atoi (value));
 		else if (!strcmp (name, "-mlfqs"))
 			thread_mlfqs = true;
+		else if (!strcmp (name, "-cfs"))
+			thread_cfs = true;
+		else if (!strcmp (name, "-adaptive")) {
+			if (!thread_set_adaptive (value))
+				PANIC ("bad -adaptive slices `%s' (use -h for help)", value);
+		}
+		else if (!strcmp (name, "-nohz"))
+			timer_nohz = true;
+		else if (!strcmp (name, "-stack-guard"))
+			thread_stack_guard = true;
+		else if (!strcmp (name, "-lockstat"))
+			lockstat_enabled = true;
+		else if (!strcmp (name, "-profile"))
+			profile_enabled = true;
 #ifdef USERPROG
 		else if (!strcmp (name, "-ul"))
 			user_page_limit = atoi (value);
 		else if (!strcmp (name, "-threads-tests"))
 			thread_tests = true;
+		else if (!strcmp (name, "-rusage"))
+			process_rusage_report = true;
 #endif
 		else
 			PANIC ("unknown option `%s' (use -h for help)", name);
 	}
+	if (thread_mlfqs && thread_cfs)
+		PANIC ("-mlfqs and -cfs are mutually exclusive");
+	if (thread_adaptive && (thread_mlfqs || thread_cfs))
+		PANIC ("-adaptive only applies to the priority scheduler");
 
 	return argv;
 }
@@ -326,8 +351,16 @@ usage (void) {
 			"  -f                 Format file system disk during startup.\n"
 			"  -rs=SEED           Set random number seed to SEED.\n"
 			"  -mlfqs             Use multi-level feedback queue scheduler.\n"
+			"  -cfs               Use completely fair scheduler.\n"
+			"  -adaptive[=L,M,H]  Adapt time slices to thread behavior; L,M,H\n"
+			"                     are the low/mid/high band slices in ticks.\n"
+			"  -nohz              Stop the periodic timer tick while idle.\n"
+			"  -stack-guard       Put an unmapped guard page below each thread.\n"
+			"  -lockstat          Collect lock contention statistics.\n"
+			"  -profile           Sample call stacks on every timer tick.\n"
 #ifdef USERPROG
 			"  -ul=COUNT          Limit user memory to COUNT pages.\n"
+			"  -rusage            Print resource usage when a process exits.\n"
 #endif
 			);
 	power_off ();
@@ -354,6 +387,9 @@ static void
 print_stats (void) {
 	timer_print_stats ();
 	thread_print_stats ();
+	trace_print_stats ();
+	lockstat_print_stats ();
+	profile_print_stats ();
 #ifdef FILESYS
 	disk_print_stats ();
 #endif
@@ -362,4 +398,7 @@ print_stats (void) {
 #ifdef USERPROG
 	exception_print_stats ();
 #endif
+#ifdef VM
+	vm_print_stats ();
+#endif
 }
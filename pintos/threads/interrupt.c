@@ -13,9 +13,11 @@
 #include "threads/mmu.h"
 #include "threads/thread.h"
 #include "threads/vaddr.h"
+#include "threads/workqueue.h"
 
 #ifdef USERPROG
 #include "userprog/gdt.h"
+#include "userprog/process.h"
 #endif
 
 /* Number of x86_64 interrupts. */
@@ -97,8 +99,14 @@ static const char *intr_names[INTR_CNT];
    pre-empted.  Handlers for external interrupts also may not
    sleep, although they may invoke intr_yield_on_return() to
    request that a new process be scheduled just before the
-   interrupt returns. */
+   interrupt returns.
+
+   Once the interrupt is acknowledged, the outermost handler runs
+   the bottom halves raised with softirq_raise() with interrupts
+   on.  Interrupts taken meanwhile nest on top of them but leave
+   the bottom halves and the final yield to the outer handler. */
 static bool in_external_intr; /* Are we processing an external interrupt? */
+static bool in_softirq;       /* Are we running bottom halves? */
 static bool yield_on_return;  /* Should we yield on interrupt return? */
 
 /* Programmable Interrupt Controller helpers. */
@@ -130,7 +138,7 @@ enum intr_level intr_set_level(enum intr_level level) {
 /* Enables interrupts and returns the previous interrupt status. */
 enum intr_level intr_enable(void) {
   enum intr_level old_level = intr_get_level();
-  ASSERT(!intr_context());
+  ASSERT(!in_external_intr);
 
   /* Enable interrupts by setting the interrupt flag.
 
@@ -159,6 +167,7 @@ void intr_init(void) {
 
   /* Initialize interrupt controller. */
   pic_init();
+  softirq_init();
 
   /* Initialize IDT. */
   for (i = 0; i < INTR_CNT; i++) {
@@ -240,9 +249,9 @@ void intr_register_int(uint8_t vec_no, int dpl, enum intr_level level,
   register_handler(vec_no, dpl, level, handler, name);
 }
 
-/* Returns true during processing of an external interrupt
-   and false at all other times. */
-bool intr_context(void) { return in_external_intr; }
+/* Returns true during processing of an external interrupt or of
+   the bottom halves it raised, and false at all other times. */
+bool intr_context(void) { return in_external_intr || in_softirq; }
 
 /* During processing of an external interrupt, directs the
    interrupt handler to yield to a new process just before
@@ -318,12 +327,18 @@ void intr_handler(struct intr_frame *frame) {
      and they need to be acknowledged on the PIC (see below).
      An external interrupt handler cannot sleep. */
   external = frame->vec_no >= 0x20 && frame->vec_no < 0x30;
+#ifdef USERPROG
+  if ((frame->cs & 3) == 3) thread_ru_enter_kernel();
+#endif
   if (external) {
     ASSERT(intr_get_level() == INTR_OFF);
-    ASSERT(!intr_context());
+    ASSERT(!in_external_intr);
 
     in_external_intr = true;
-    yield_on_return = false;
+    if (!in_softirq) yield_on_return = false;  // 중첩된 경우 바깥의 요청 유지
+
+    /* idle 중 멈춰 두었던 주기 tick을 먼저 따라잡는다. */
+    timer_idle_exit();
   }
 
   /* Invoke the interrupt's handler. */
@@ -349,8 +364,24 @@ void intr_handler(struct intr_frame *frame) {
     in_external_intr = false;
     pic_end_of_interrupt(frame->vec_no);
 
-    if (yield_on_return) thread_yield();
+    /* bottom half와 yield는 가장 바깥 인터럽트에서만 */
+    if (!in_softirq) {
+      in_softirq = true;
+      softirq_run();
+      in_softirq = false;
+
+      if (yield_on_return) thread_yield();
+    }
   }
+
+#ifdef USERPROG
+  /* 유저 모드로 돌아가기 직전, 같은 프로세스의 다른 쓰레드가
+     프로세스를 끝내는 중이면 이 쓰레드도 끝낸다. */
+  if ((frame->cs & 3) == 3) {
+    process_check_exit();
+    thread_ru_leave_kernel();
+  }
+#endif
 }
 
 /* Dumps interrupt frame F to the console, for debugging. */
@@ -0,0 +1,167 @@
+#include "threads/lockstat.h"
+
+#include <debug.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "threads/interrupt.h"
+
+/* Set by the "-lockstat" kernel command-line option. */
+bool lockstat_enabled;
+
+/* One record per initialization site, plus one per named lock,
+   in registration order.
+   Records are never freed, so struct lock may keep a plain
+   pointer to its own.  Updated with interrupts off. */
+static struct lock_stat classes[LOCKSTAT_MAX];
+static int class_cnt;
+static long long class_overflow; /* 표가 가득 차서 기록하지 못한 init 수 */
+
+/* Returns the record for locks or semaphores of KIND initialized
+   at SITE, creating it if needed, or NULL if lockstat is off or
+   the table is full. */
+struct lock_stat *lockstat_register(enum lock_stat_kind kind, const void *site) {
+  struct lock_stat *s = NULL;
+
+  if (!lockstat_enabled) return NULL;
+
+  enum intr_level old_level = intr_disable();
+  for (int i = 0; i < class_cnt; i++)
+    if (classes[i].site == (uint64_t)site && classes[i].kind == kind && classes[i].instance == 0) {
+      s = &classes[i];
+      break;
+    }
+  if (s == NULL && class_cnt < LOCKSTAT_MAX) {
+    s = &classes[class_cnt++];
+    s->site = (uint64_t)site;
+    s->kind = kind;
+  }
+  if (s != NULL)
+    s->instances++;
+  else
+    class_overflow++;
+  intr_set_level(old_level);
+  return s;
+}
+
+/* Moves the lock at INSTANCE from its record S to a record of its
+   own named NAME, keyed by INSTANCE as well as S's site, and
+   returns the new record.  Returns S if the table is full.  S may
+   be NULL. */
+struct lock_stat *lockstat_set_name(struct lock_stat *s, const void *instance, const char *name) {
+  struct lock_stat *inst = NULL;
+
+  if (s == NULL) return NULL;
+
+  enum intr_level old_level = intr_disable();
+  for (int i = 0; i < class_cnt; i++)
+    if (classes[i].site == s->site && classes[i].kind == s->kind && classes[i].instance == (uint64_t)instance) {
+      inst = &classes[i];
+      break;
+    }
+  if (inst == NULL && class_cnt < LOCKSTAT_MAX) {
+    inst = &classes[class_cnt++];
+    inst->site = s->site;
+    inst->kind = s->kind;
+    inst->instance = (uint64_t)instance;
+  }
+  if (inst == NULL) {
+    inst = s;  // 표가 가득 찼으면 클래스 기록에 남긴다
+  } else if (inst != s) {
+    s->instances--;
+    inst->instances++;
+  }
+  if (inst != s || s->instance != 0) strlcpy(inst->name, name, sizeof inst->name);
+  intr_set_level(old_level);
+  return inst;
+}
+
+/* Records an acquisition of a lock or semaphore of S that waited
+   WAIT_NS if CONTENDED.  Interrupts must be off. */
+void lockstat_acquired(struct lock_stat *s, bool contended, uint64_t wait_ns) {
+  ASSERT(intr_get_level() == INTR_OFF);
+
+  s->acquired++;
+  if (!contended) return;
+  s->contended++;
+  lockstat_waited(s, wait_ns);
+}
+
+/* Adds WAIT_NS to the time spent waiting for a lock of S, e.g. a
+   writer waiting for the readers of an rwlock to leave.
+   Interrupts must be off. */
+void lockstat_waited(struct lock_stat *s, uint64_t wait_ns) {
+  ASSERT(intr_get_level() == INTR_OFF);
+
+  s->wait_ns += wait_ns;
+  if (wait_ns > s->wait_max_ns) s->wait_max_ns = wait_ns;
+}
+
+/* Records that a lock of S was released after being held for
+   HOLD_NS.  Interrupts must be off. */
+void lockstat_released(struct lock_stat *s, uint64_t hold_ns) {
+  ASSERT(intr_get_level() == INTR_OFF);
+
+  s->hold_ns += hold_ns;
+  if (hold_ns > s->hold_max_ns) s->hold_max_ns = hold_ns;
+}
+
+/* Records that a waiter for a lock of S passed its priority along
+   a chain of DEPTH threads.  Interrupts must be off. */
+void lockstat_depth(struct lock_stat *s, int depth) {
+  ASSERT(intr_get_level() == INTR_OFF);
+
+  if ((uint32_t)depth > s->max_depth) s->max_depth = depth;
+}
+
+/* Copies up to MAX records to STATS and returns how many were
+   copied. */
+int lockstat_snapshot(struct lock_stat *stats, int max) {
+  enum intr_level old_level = intr_disable();
+  int n = class_cnt < max ? class_cnt : max;
+
+  memcpy(stats, classes, n * sizeof *stats);
+  intr_set_level(old_level);
+  return n;
+}
+
+/* Prints the classes that ever had to wait, most total wait
+   first, followed by a count of those that never did. */
+void lockstat_print_stats(void) {
+  static bool printed[LOCKSTAT_MAX];
+  int quiet = 0;
+
+  if (!lockstat_enabled) return;
+
+  printf("Lock statistics: %d classes, times in us", class_cnt);
+  if (class_overflow > 0) printf(", %lld inits not recorded", class_overflow);
+  printf("\n%-23s %4s %9s %8s %10s %10s %10s %10s %5s\n", "name", "kind", "acquired", "contend", "wait",
+         "max-wait", "hold", "max-hold", "depth");
+
+  // 선택 정렬: 종료 시 한 번, 많아야 LOCKSTAT_MAX개
+  for (;;) {
+    struct lock_stat *s = NULL;
+    int best = -1;
+
+    for (int i = 0; i < class_cnt; i++)
+      if (!printed[i] && classes[i].wait_ns > 0 && (s == NULL || classes[i].wait_ns > s->wait_ns)) {
+        s = &classes[i];
+        best = i;
+      }
+    if (s == NULL) break;
+    printed[best] = true;
+
+    char name[LOCK_STAT_NAME_LEN + 1];
+    if (s->name[0] != '\0')
+      strlcpy(name, s->name, sizeof name);
+    else
+      snprintf(name, sizeof name, "%#" PRIx64, s->site);
+    printf("%-23s %4s %9" PRIu64 " %8" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %5" PRIu32 "\n",
+           name, s->kind == LOCK_STAT_LOCK ? "lock" : "sema", s->acquired, s->contended, s->wait_ns / 1000,
+           s->wait_max_ns / 1000, s->hold_ns / 1000, s->hold_max_ns / 1000, s->max_depth);
+  }
+  for (int i = 0; i < class_cnt; i++)
+    if (classes[i].wait_ns == 0) quiet++;
+  printf("%d classes never waited.\n", quiet);
+}
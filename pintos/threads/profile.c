@@ -0,0 +1,171 @@
+#include "threads/profile.h"
+
+#include <debug.h>
+#include <inttypes.h>
+#include <round.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "threads/loader.h"
+#include "threads/palloc.h"
+#include "threads/thread.h"
+#include "threads/vaddr.h"
+#ifdef USERPROG
+#include "threads/mmu.h"
+#endif
+
+/* Set by the "-profile" kernel command-line option. */
+bool profile_enabled;
+
+/* A distinct call stack and the number of samples that hit it.
+   PC[0] is the interrupted instruction, PC[DEPTH - 1] the
+   outermost frame found. */
+struct profile_stack {
+  uint32_t count;              /* Samples, 0 if the slot is free. */
+  uint8_t depth;               /* Frames in PC. */
+  bool user;                   /* Sampled in user mode? */
+  uint64_t pc[PROFILE_DEPTH];  /* Return addresses, leaf first. */
+};
+
+/* Per-CPU open-addressed hash table of stacks.  Written only by
+   the owning CPU's timer interrupt. */
+#define PROFILE_SLOTS 1024
+struct profile_cpu {
+  uint64_t samples;                           /* Samples taken. */
+  uint64_t dropped;                           /* Samples lost to a full table. */
+  struct profile_stack slots[PROFILE_SLOTS];  /* Distinct stacks. */
+};
+
+/* Indexed by CPU id.  NULL until profile_init(). */
+static struct profile_cpu *profile_cpus[CPU_MAX];
+
+static int walk_kernel(const struct intr_frame *, uint64_t pc[PROFILE_DEPTH]);
+static int walk_user(const struct intr_frame *, uint64_t pc[PROFILE_DEPTH]);
+static void count(struct profile_cpu *, bool user, const uint64_t *pc, int depth);
+
+/* Allocates sample tables for CPUs 0 through CPU_CNT - 1 if the
+   profiler is enabled.  Called by thread_start(), after the page
+   allocator is up. */
+void profile_init(int cpu_cnt) {
+  size_t pages = DIV_ROUND_UP(sizeof(struct profile_cpu), PGSIZE);
+
+  if (!profile_enabled) return;
+  ASSERT(cpu_cnt <= CPU_MAX);
+  for (int i = 0; i < cpu_cnt; i++)
+    if (profile_cpus[i] == NULL) profile_cpus[i] = palloc_get_multiple(PAL_ASSERT | PAL_ZERO, pages);
+}
+
+/* Takes one sample of the code interrupted with frame F.  Called
+   from the timer interrupt. */
+void profile_sample(const struct intr_frame *f) {
+  struct profile_cpu *prof = profile_cpus[thread_cpu_id()];
+  uint64_t stack[PROFILE_DEPTH];
+  bool user = (f->cs & 3) == 3;
+
+  if (prof == NULL) return;
+  int depth = user ? walk_user(f, stack) : walk_kernel(f, stack);
+  prof->samples++;
+  count(prof, user, stack, depth);
+}
+
+/* Prints every CPU's stacks in folded form, root first. */
+void profile_print_stats(void) {
+  uint64_t samples = 0, dropped = 0;
+
+  if (!profile_enabled) return;
+  for (int i = 0; i < CPU_MAX; i++)
+    if (profile_cpus[i] != NULL) {
+      samples += profile_cpus[i]->samples;
+      dropped += profile_cpus[i]->dropped;
+    }
+  printf("Profile: %" PRIu64 " samples, %" PRIu64 " dropped\n", samples, dropped);
+
+  for (int i = 0; i < CPU_MAX; i++) {
+    struct profile_cpu *prof = profile_cpus[i];
+    if (prof == NULL) continue;
+    for (int s = 0; s < PROFILE_SLOTS; s++) {
+      struct profile_stack *st = &prof->slots[s];
+      if (st->count == 0) continue;
+      printf("PROF %s", st->user ? "user" : "kernel");
+      for (int d = st->depth - 1; d >= 0; d--) printf(";%#" PRIx64, st->pc[d]);
+      printf(" %" PRIu32 "\n", st->count);
+    }
+  }
+}
+
+/* Walks the kernel stack interrupted with frame F into PC and
+   returns the number of frames.  Only frames that lie within the
+   interrupted thread's page are followed, so a corrupt chain ends
+   the walk instead of faulting. */
+static int walk_kernel(const struct intr_frame *f, uint64_t pc[PROFILE_DEPTH]) {
+  uint64_t lo = (uint64_t)pg_round_down((void *)f->R.rbp);
+  uint64_t hi = lo + PGSIZE;
+  uint64_t *frame = (uint64_t *)f->R.rbp;
+  int depth = 0;
+
+  pc[depth++] = f->rip;
+  // rbp가 인터럽트 당한 쓰레드의 스택 안에 있어야 함
+  if (lo != (uint64_t)thread_current()) return depth;
+  while (depth < PROFILE_DEPTH && (uint64_t)frame >= lo && (uint64_t)(frame + 2) <= hi && frame[1] != 0) {
+    pc[depth++] = frame[1];
+    if (frame[0] <= (uint64_t)frame) break;  // 스택은 위로만 거슬러 올라감
+    frame = (uint64_t *)frame[0];
+  }
+  return depth;
+}
+
+#ifdef USERPROG
+/* Reads the user word at UADDR in the running process through its
+   page table, without faulting.  Returns false if it is not
+   mapped. */
+static bool read_user_word(uint64_t uaddr, uint64_t *word) {
+  struct thread *t = thread_current();
+  uint8_t *kva;
+
+  if (t->pml4 == NULL || uaddr % sizeof *word != 0 || !is_user_vaddr((void *)uaddr)) return false;
+  kva = pml4_get_page(t->pml4, (void *)uaddr);
+  if (kva == NULL) return false;
+  *word = *(uint64_t *)kva;
+  return true;
+}
+#endif
+
+/* Walks the user stack interrupted with frame F into PC and
+   returns the number of frames.  User programs are also built
+   with frame pointers. */
+static int walk_user(const struct intr_frame *f, uint64_t pc[PROFILE_DEPTH]) {
+  int depth = 0;
+
+  pc[depth++] = f->rip;
+#ifdef USERPROG
+  uint64_t frame = f->R.rbp, next, ret;
+  while (depth < PROFILE_DEPTH && read_user_word(frame, &next) && read_user_word(frame + 8, &ret) && ret != 0) {
+    pc[depth++] = ret;
+    if (next <= frame) break;
+    frame = next;
+  }
+#endif
+  return depth;
+}
+
+/* Counts one sample of the DEPTH-frame stack PC in PROF.  A stack
+   that finds no free slot within a few probes is dropped rather
+   than slowing down the interrupt. */
+static void count(struct profile_cpu *prof, bool user, const uint64_t *pc, int depth) {
+  uint64_t hash = 14695981039346656037ULL + user;  // FNV-1a
+
+  for (int d = 0; d < depth; d++) hash = (hash ^ pc[d]) * 1099511628211ULL;
+  for (int probe = 0; probe < 16; probe++) {
+    struct profile_stack *st = &prof->slots[(hash + probe) % PROFILE_SLOTS];
+
+    if (st->count == 0) {
+      st->user = user;
+      st->depth = depth;
+      memcpy(st->pc, pc, depth * sizeof *pc);
+    } else if (st->user != user || st->depth != depth || memcmp(st->pc, pc, depth * sizeof *pc) != 0)
+      continue;
+    st->count++;
+    return;
+  }
+  prof->dropped++;
+}
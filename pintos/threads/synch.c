@@ -31,8 +31,33 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "devices/timer.h"
 #include "threads/interrupt.h"
+#include "threads/lockstat.h"
 #include "threads/thread.h"
+#include "threads/trace.h"
+
+/* Maximum length of a priority donation chain. */
+#define DONATION_DEPTH 8
+
+static void sema_setup(struct semaphore *sema, unsigned value);
+static void lock_setup(struct lock *lock, const void *site);
+static int refresh_priority(struct thread *t, int depth);
+static void lock_cache_donor(struct lock *lock);
+static int rwlock_donate(struct rwlock *rw, int depth);
+static void lock_update_donor(struct lock *lock);
+static void cond_waiter_update(struct semaphore_elem *waiter);
+
+/* Orders threads waiting on a semaphore by priority. */
+static bool waiter_less(const struct heap_elem *a, const struct heap_elem *b, void *aux UNUSED) {
+  return heap_entry(a, struct thread, wait_elem)->priority < heap_entry(b, struct thread, wait_elem)->priority;
+}
+
+/* heap_apply() action: brings a blocked waiter's MLFQS priority up
+   to date before the heap is reordered. */
+static void waiter_refresh(struct heap_elem *e, void *aux UNUSED) {
+  thread_mlfqs_refresh(heap_entry(e, struct thread, wait_elem));
+}
 
 /* Initializes semaphore SEMA to VALUE.  A semaphore is a
    nonnegative integer along with two atomic operators for
@@ -44,10 +69,18 @@
    - up or "V": increment the value (and wake up one waiting
    thread, if any). */
 void sema_init(struct semaphore *sema, unsigned value) {
+  sema_setup(sema, value);
+  sema->stat = lockstat_register(LOCK_STAT_SEMA, __builtin_return_address(0));
+}
+
+/* sema_init() without statistics, for semaphores that are part of
+   another primitive. */
+static void sema_setup(struct semaphore *sema, unsigned value) {
   ASSERT(sema != NULL);
 
   sema->value = value;
-  list_init(&sema->waiters);
+  heap_init(&sema->waiters, waiter_less, NULL);
+  sema->stat = NULL;
 }
 
 /* Down or "P" operation on a semaphore.  Waits for SEMA's value
@@ -65,13 +98,53 @@ void sema_down(struct semaphore *sema) {
   ASSERT(!intr_context());
 
   old_level = intr_disable();
-  while (sema->value == 0) {  // sema_up에서 최댓값을 가져오므로 넣을때는 끝에서부터 걍 넣자
-    list_push_back(&sema->waiters, &thread_current()->elem);
+  bool contended = sema->value == 0;
+  uint64_t start = sema->stat != NULL && contended ? timer_now_ns() : 0;
+  while (sema->value == 0) {  // priority 힙에 넣고 잠든다. sema_up이 top을 깨움
+    struct thread *curr = thread_current();
+    struct lock *lock = curr->waiting_for_lock;
+
+    heap_push(&sema->waiters, &curr->wait_elem);
+    curr->wait_heap = &sema->waiters;
+    // 락을 기다리는 중이라면 holder에게 priority donate
+    if (lock != NULL && &lock->semaphore == sema) lock_update_donor(lock);
 
     thread_block();
   }
   sema->value--;
+  if (sema->stat != NULL) lockstat_acquired(sema->stat, contended, contended ? timer_now_ns() - start : 0);
+  intr_set_level(old_level);
+}
+
+/* Like sema_down(), but gives up and returns false, leaving SEMA
+   unchanged, if the running thread is interrupted with
+   thread_interrupt() before or while it waits.  Returns true once
+   SEMA has been decremented.  Must not be used for the semaphore
+   of a lock. */
+bool sema_down_interruptible(struct semaphore *sema) {
+  enum intr_level old_level;
+  struct thread *curr = thread_current();
+
+  ASSERT(sema != NULL);
+  ASSERT(!intr_context());
+
+  old_level = intr_disable();
+  bool contended = sema->value == 0;
+  uint64_t start = sema->stat != NULL && contended ? timer_now_ns() : 0;
+  while (sema->value == 0) {
+    // 인터럽트되면 thread_interrupt()가 이미 힙에서 빼 두었다
+    if (curr->interrupted) {
+      intr_set_level(old_level);
+      return false;
+    }
+    heap_push(&sema->waiters, &curr->wait_elem);
+    curr->wait_heap = &sema->waiters;
+    thread_block_interruptible();
+  }
+  sema->value--;
+  if (sema->stat != NULL) lockstat_acquired(sema->stat, contended, contended ? timer_now_ns() - start : 0);
   intr_set_level(old_level);
+  return true;
 }
 
 /* Down or "P" operation on a semaphore, but only if the
@@ -88,6 +161,7 @@ bool sema_try_down(struct semaphore *sema) {
   old_level = intr_disable();
   if (sema->value > 0) {
     sema->value--;
+    if (sema->stat != NULL) lockstat_acquired(sema->stat, false, 0);
     success = true;
   } else
     success = false;
@@ -108,11 +182,12 @@ void sema_up(struct semaphore *sema) {
   old_level = intr_disable();
 
   sema->value++;  // good
-  if (!list_empty(&sema->waiters)) {
-    // sema->waiters 중에서 우선순위 최댓값인거 가져와야 함. 비교함수가 반대여서 min을 씀...(최댓값뽑는게맞음)
-    struct list_elem *max_elem = list_min(&sema->waiters, thread_priority_less, NULL);
-    struct thread *t = list_entry(max_elem, struct thread, elem);
-    list_remove(max_elem);  // 삭제까지 해줘야함 원래 pop이었으니까
+  if (!heap_empty(&sema->waiters)) {
+    // mlfqs: 잠든 동안 갱신되지 않은 대기자들의 priority를 먼저 최신화
+    if (thread_mlfqs) heap_apply(&sema->waiters, waiter_refresh, NULL);
+    // 힙의 top이 우선순위 최댓값, O(log n)
+    struct thread *t = heap_entry(heap_pop(&sema->waiters), struct thread, wait_elem);
+    t->wait_heap = NULL;
     thread_unblock(t);
   }
   intr_set_level(old_level);
@@ -164,23 +239,127 @@ static void sema_test_helper(void *sema_) {
    acquire and release it.  When these restrictions prove
    onerous, it's a good sign that a semaphore should be used,
    instead of a lock. */
-void lock_init(struct lock *lock) {
+void lock_init(struct lock *lock) { lock_setup(lock, __builtin_return_address(0)); }
+
+/* lock_init() for a lock whose statistics go to the class of
+   SITE. */
+static void lock_setup(struct lock *lock, const void *site) {
   ASSERT(lock != NULL);
 
   lock->holder = NULL;
-  sema_init(&lock->semaphore, 1);
+  lock->donation.priority = -1;
+  sema_setup(&lock->semaphore, 1);  // 세마포어가 아니라 락으로 집계
+  lock->stat = lockstat_register(LOCK_STAT_LOCK, site);
+  lock->stat_taken = 0;
+}
+
+/* Gives LOCK a record of its own, named NAME, in lock
+   statistics. */
+void lock_set_name(struct lock *lock, const char *name) { lock->stat = lockstat_set_name(lock->stat, lock, name); }
+
+/* Orders the donations a thread receives through the locks it
+   holds. */
+bool donation_less(const struct heap_elem *a, const struct heap_elem *b, void *aux UNUSED) {
+  return heap_entry(a, struct donation, elem)->priority < heap_entry(b, struct donation, elem)->priority;
+}
+
+/* Recomputes T's priority as the larger of its own priority and
+   the best donation among the locks it holds, which is the top of
+   T->held_locks.  If that changes T's priority, T is re-keyed
+   wherever it is queued and the change is passed on to the holder
+   of the lock T is waiting for, up to DONATION_DEPTH levels.
+   Interrupts must be off.  Does nothing under the MLFQS, which
+   has no donation. */
+void lock_refresh_priority(struct thread *t) {
+  ASSERT(intr_get_level() == INTR_OFF);
+  if (thread_mlfqs) return;
+  refresh_priority(t, 0);
+}
+
+/* lock_refresh_priority() starting DEPTH levels down a donation
+   chain.  Returns the number of threads whose priority changed
+   along the chain. */
+static int refresh_priority(struct thread *t, int depth) {
+  int changed = 0;
+
+  for (; t != NULL && depth < DONATION_DEPTH; depth++) {
+    int priority = t->original_priority;
+
+    if (!heap_empty(&t->held_locks)) {
+      struct donation *top = heap_entry(heap_top(&t->held_locks), struct donation, elem);
+      if (top->priority > priority) priority = top->priority;
+    }
+    if (priority == t->priority) break;  // 변화가 없으면 체인 위쪽도 그대로
+    int old_priority = t->priority;
+    t->priority = priority;
+    trace_priority(t, old_priority);
+    changed++;
+
+    // 새 우선순위로 각 큐에서 재정렬 (O(log n))
+    if (t->status == THREAD_READY) thread_requeue(t);
+    if (t->wait_heap != NULL) heap_update(t->wait_heap, &t->wait_elem);
+    if (t->cond_waiter != NULL) cond_waiter_update(t->cond_waiter);
+
+    // writer로서 reader들을 기다리는 중이라면 모든 reader에게 전달
+    if (t->waiting_for_readers != NULL) {
+      changed += rwlock_donate(t->waiting_for_readers, depth + 1);
+      break;
+    }
+
+    // 다음 체인 확인 : 이 스레드가 다른 락을 기다리고 있는가
+    struct lock *lock = t->waiting_for_lock;
+    if (lock == NULL || lock->holder == NULL) break;
+    lock_cache_donor(lock);
+    t = lock->holder;
+  }
+  return changed;
+}
+
+/* Refreshes LOCK's cached donation from the top of its wait
+   queue and re-keys it in its holder's held_locks. */
+static void lock_cache_donor(struct lock *lock) {
+  struct heap *waiters = &lock->semaphore.waiters;
+
+  lock->donation.priority =
+      heap_empty(waiters) ? -1 : heap_entry(heap_top(waiters), struct thread, wait_elem)->priority;
+  if (lock->holder != NULL) heap_update(&lock->holder->held_locks, &lock->donation.elem);
+}
+
+/* Called when LOCK's wait queue has changed: updates the cached
+   donation and passes it on to the holder. */
+static void lock_update_donor(struct lock *lock) {
+  if (thread_mlfqs) return;
+  lock_cache_donor(lock);
+  int depth = refresh_priority(lock->holder, 0);
+  if (lock->stat != NULL) lockstat_depth(lock->stat, depth);
+}
+
+/* Makes the current thread the holder of LOCK, whose semaphore it
+   has just downed.  Threads still waiting on LOCK now donate to
+   us.  Interrupts must be off. */
+static void lock_take(struct lock *lock) {
+  struct thread *curr = thread_current();
+
+  lock_cache_donor(lock);  // 아직 holder가 없으니 값만 갱신
+  lock->holder = curr;
+  heap_push(&curr->held_locks, &lock->donation.elem);
+  lock_refresh_priority(curr);
+  if (lock->stat != NULL) lock->stat_taken = timer_now_ns();
 }
 
-static void donate_priority_dfs(struct thread *holder, int prioirty);
 /* Acquires LOCK, sleeping until it becomes available if
    necessary.  The lock must not already be held by the current
    thread.
 
+   If LOCK is held, the current thread donates its priority to
+   the holder while it waits; sema_down() queues it by priority
+   and hands the donation to lock_update_donor().
+
    This function may sleep, so it must not be called within an
    interrupt handler.  This function may be called with
    interrupts disabled, but interrupts will be turned back on if
    we need to sleep. */
-void lock_acquire(struct lock *lock) {  // P 함수의 wrapper, 해당 락을 점유하고있는 holder를 찾아가 donate
+void lock_acquire(struct lock *lock) {  // P 함수의 wrapper, 대기 중에는 holder에게 donate
   ASSERT(lock != NULL);
   ASSERT(!intr_context());
   ASSERT(!lock_held_by_current_thread(lock));
@@ -188,59 +367,19 @@ void lock_acquire(struct lock *lock) {  // P 함수의 wrapper, 해당 락을 
   enum intr_level old_level = intr_disable();
   struct thread *curr = thread_current();
 
-  // priority donate nested
-  if (lock->holder != NULL) {
-    donate_priority_dfs(lock->holder, curr->priority);  // 해당 lock의 holder부터 시작해서 dfs로 우선순위 donate
-  }
-
-  curr->waiting_for_lock = lock;  //쓰레드 waiting_for_lock 필드 갱신
+  bool contended = lock->semaphore.value == 0;
+  uint64_t start = lock->stat != NULL && contended ? timer_now_ns() : 0;
 
-  intr_set_level(old_level);
-  sema_down(&lock->semaphore);  // 여기서 block 당함
+  curr->waiting_for_lock = lock;  // 쓰레드 waiting_for_lock 필드 갱신
+  sema_down(&lock->semaphore);    // 여기서 block 당함
 
   /* 락 획득 후 처리 */
-  old_level = intr_disable();     // 인터럽트 끄기(전역 데이터를 수정하기 때문에)
   curr->waiting_for_lock = NULL;  // 이젠 이 락에 대해선 안 기다리니까
-  lock->holder = curr;            // 만약 뚫었다면 현재 스레드가 이 lock의 holder임
-  curr->is_donated += 1;          // 내가 락을 소유하게 되었으니 is_donated 추가
-  list_push_back(&curr->acquired_locks, &lock->holder_elem);  // 보유중인 락에 추가 이건 순서 상관없음
-  intr_set_level(old_level);                                  // 인터럽트 복원
-}
-static void donate_priority_dfs(struct thread *holder, int prioirty) {
-  int depth = 0;
-  const int MAX_DEPTH = 8;
-
-  struct thread *curr = holder;  // 첫 시작은 해당 락의 holder 부터
-
-  // struct thread* visited[MAX_DEPTH]; // 여태 방문한 thread를 저장
-  // int visited_count=0; //방문 횟수
-  while (curr != NULL && depth < MAX_DEPTH) {
-    // visited 배열을 순회하면서 현재 들어와 있는 쓰레드가 혹시 이미 방문했다면 false 반환
-    // for(int i=0;i<visited_count;i++)
-    //   if(visited[i]==curr) return false; // 순환발견, donation 중단
-
-    if (curr->priority >= prioirty)  //우선순위가 이미 높거나 같다면
-      break;                         //중단
-
-    // priority donation 수행
-    curr->priority = prioirty;
-
-    // ready_list에 있다면 재정렬
-    if (curr->status == THREAD_READY) {
-      list_remove(&curr->elem);
-      list_insert_ordered(get_ready_list(), &curr->elem, thread_priority_less, NULL);
-    }
-
-    // 다음 체인 확인 : 이 스레드가 다른 락을 기다리고 있는가
-    if (curr->waiting_for_lock == NULL) {  // 다른 락을 기다리고 있지 않다면
-      break;                               // 중단
-    }
-
-    //다른 락을 기다리고 있다면 다음 holder로 이동
-    curr = curr->waiting_for_lock->holder;
-    depth++;
-  }
+  if (lock->stat != NULL) lockstat_acquired(lock->stat, contended, contended ? timer_now_ns() - start : 0);
+  lock_take(lock);                // 현재 스레드가 이 lock의 holder
+  intr_set_level(old_level);      // 인터럽트 복원
 }
+
 /* Tries to acquires LOCK and returns true if successful or false
    on failure.  The lock must not already be held by the current
    thread.
@@ -253,14 +392,23 @@ bool lock_try_acquire(struct lock *lock) {
   ASSERT(lock != NULL);
   ASSERT(!lock_held_by_current_thread(lock));
 
+  enum intr_level old_level = intr_disable();
   success = sema_try_down(&lock->semaphore);
-  if (success) lock->holder = thread_current();
+  if (success) {
+    if (lock->stat != NULL) lockstat_acquired(lock->stat, false, 0);
+    lock_take(lock);
+  }
+  intr_set_level(old_level);
   return success;
 }
 
 /* Releases LOCK, which must be owned by the current thread.
    This is lock_release function.
 
+   The donation LOCK carried is dropped by removing it from
+   held_locks; our priority becomes the best remaining donation
+   or our own priority, whichever is higher, in O(log n).
+
    An interrupt handler cannot acquire a lock, so it does not
    make sense to try to release a lock within an interrupt
    handler. */
@@ -271,29 +419,14 @@ void lock_release(struct lock *lock) {  // V함수의 wrapper
   enum intr_level old_level = intr_disable();
   struct thread *curr = thread_current();
 
-  //현재 쓰레드의 acquired locks에서 노드 제거
-  list_remove(&lock->holder_elem);
-
-  // 우선순위 복구 내가 가지고 있는 acquire lock 중에서 가장 큰 걸로 받아와야함
-  int new_priority = curr->original_priority;
-
-  struct list_elem *e;  // acquired locks를 순회하면서 각각의 락
-  // 현재 스레드가 보유중인 락을 순회 하면서 각 락의 우선순위 최댓값을 new_priority로 함(물론 내 original이 높다면
-  // 그걸로 채택)
-  for (e = list_begin(&curr->acquired_locks); e != list_end(&curr->acquired_locks); e = list_next(e)) {
-    struct lock *other_lock = list_entry(e, struct lock, holder_elem);
-
-    if (list_empty(&other_lock->semaphore.waiters)) continue;  // 대기자가 없는 락은 pass
-
-    struct thread *front_thread = list_entry(list_front(&other_lock->semaphore.waiters), struct thread, elem);
+  heap_remove(&curr->held_locks, &lock->donation.elem);  // 이 락으로 받던 기부 회수
+  lock->holder = NULL;
+  if (lock->stat != NULL) lockstat_released(lock->stat, timer_now_ns() - lock->stat_taken);
+  lock_refresh_priority(curr);  // 남은 락들 중 최대 donor 또는 원래 priority
 
-    if (front_thread->priority > new_priority)  // 각 락의 우선순위 최댓값을 가지고 new_priority 갱신
-      new_priority = front_thread->priority;
-  }
-  curr->priority = new_priority;  // 현재 스레드의 적절한 priority로 갱신
-  curr->is_donated -= 1;          // 내가 풀었으니까 is_donated 하나 내리기
+  if (!heap_empty(&lock->semaphore.waiters))
+    trace_lock_handoff(lock, heap_entry(heap_top(&lock->semaphore.waiters), struct thread, wait_elem));
 
-  lock->holder = NULL;
   sema_up(&lock->semaphore);  // 자원 1 공급해주고 waiter 중 우선순위 높은 쓰레드 unblock
   intr_set_level(old_level);
 }
@@ -307,19 +440,172 @@ bool lock_held_by_current_thread(const struct lock *lock) {
   return lock->holder == thread_current();
 }
 
-/* One semaphore in a list. */
+/* Initializes readers-writer lock RW. */
+void rwlock_init(struct rwlock *rw) {
+  ASSERT(rw != NULL);
+
+  lock_setup(&rw->lock, __builtin_return_address(0));  // 통계는 rwlock_init 호출 위치로
+  rw->readers = 0;
+  list_init(&rw->reader_holds);
+  sema_setup(&rw->drain, 0);
+  rw->writer = NULL;
+}
+
+/* Gives RW a record of its own, named NAME, in lock
+   statistics. */
+void rwlock_set_name(struct rwlock *rw, const char *name) { lock_set_name(&rw->lock, name); }
+
+/* Gives every reader of RW the priority of the writer waiting for
+   them, or takes it back if no writer is waiting.  DEPTH is how
+   far down a donation chain we are.  Returns the length of the
+   longest chain of priority changes that followed.  Interrupts
+   must be off. */
+static int rwlock_donate(struct rwlock *rw, int depth) {
+  int priority = rw->writer != NULL ? rw->writer->priority : -1;
+  int changed = 0;
+
+  for (struct list_elem *e = list_begin(&rw->reader_holds); e != list_end(&rw->reader_holds); e = list_next(e)) {
+    struct rwlock_hold *hold = list_entry(e, struct rwlock_hold, elem);
+
+    if (hold->donation.priority == priority) continue;
+    hold->donation.priority = priority;
+    heap_update(&hold->thread->held_locks, &hold->donation.elem);
+    int n = refresh_priority(hold->thread, depth);
+    if (n > changed) changed = n;
+  }
+  return changed;
+}
+
+/* Acquires RW for reading, sleeping while a writer holds it or is
+   waiting for it.  Waiting readers donate their priority to that
+   writer through RW->lock, which they only pass through.  The
+   current thread must not already hold RW.
+
+   This function may sleep, so it must not be called within an
+   interrupt handler. */
+void rwlock_read_acquire(struct rwlock *rw) {
+  ASSERT(rw != NULL);
+  ASSERT(!intr_context());
+
+  struct thread *curr = thread_current();
+  struct rwlock_hold *hold = NULL;
+
+  lock_acquire(&rw->lock);  // writer가 있다면 donate하며 대기
+
+  enum intr_level old_level = intr_disable();
+  for (int i = 0; i < RWLOCK_HOLD_MAX; i++) {
+    ASSERT(curr->rw_holds[i].rwlock != rw);
+    if (hold == NULL && curr->rw_holds[i].rwlock == NULL) hold = &curr->rw_holds[i];
+  }
+  ASSERT(hold != NULL);  // RWLOCK_HOLD_MAX개보다 많이 잡을 수 없음
+
+  hold->rwlock = rw;
+  hold->thread = curr;
+  hold->donation.priority = -1;  // lock을 잡고 있으니 기다리는 writer는 없음
+  heap_push(&curr->held_locks, &hold->donation.elem);
+  list_push_back(&rw->reader_holds, &hold->elem);
+  rw->readers++;
+  intr_set_level(old_level);
+
+  lock_release(&rw->lock);
+}
+
+/* Releases RW, which the current thread holds for reading.  The
+   last reader out lets a waiting writer in. */
+void rwlock_read_release(struct rwlock *rw) {
+  ASSERT(rw != NULL);
+
+  struct thread *curr = thread_current();
+  struct rwlock_hold *hold = NULL;
+
+  for (int i = 0; i < RWLOCK_HOLD_MAX; i++)
+    if (curr->rw_holds[i].rwlock == rw) hold = &curr->rw_holds[i];
+  ASSERT(hold != NULL);
+
+  enum intr_level old_level = intr_disable();
+  list_remove(&hold->elem);
+  heap_remove(&curr->held_locks, &hold->donation.elem);  // writer에게 받던 기부 회수
+  hold->rwlock = NULL;
+  lock_refresh_priority(curr);
+
+  if (--rw->readers == 0 && rw->writer != NULL) sema_up(&rw->drain);
+  intr_set_level(old_level);
+}
+
+/* Acquires RW for writing, sleeping until no other writer holds
+   it and every reader has left.  Meanwhile new readers queue up
+   behind us and the current readers run with our priority.
+
+   This function may sleep, so it must not be called within an
+   interrupt handler. */
+void rwlock_write_acquire(struct rwlock *rw) {
+  ASSERT(rw != NULL);
+  ASSERT(!intr_context());
+
+  struct thread *curr = thread_current();
+
+  lock_acquire(&rw->lock);  // 다른 writer와 새 reader를 막는다
+
+  enum intr_level old_level = intr_disable();
+  if (rw->readers > 0) {  // 남은 reader들이 빠질 때까지 donate하며 대기
+    struct lock_stat *stat = rw->lock.stat;
+    uint64_t start = stat != NULL ? timer_now_ns() : 0;
+
+    rw->writer = curr;
+    curr->waiting_for_readers = rw;
+    if (!thread_mlfqs) {
+      int depth = rwlock_donate(rw, 1);
+      if (stat != NULL) lockstat_depth(stat, depth);
+    }
+    while (rw->readers > 0) sema_down(&rw->drain);
+    curr->waiting_for_readers = NULL;
+    rw->writer = NULL;
+    // reader를 기다린 시간도 대기 시간으로 집계 (획득 횟수는 lock_acquire에서 셌음)
+    if (stat != NULL) lockstat_waited(stat, timer_now_ns() - start);
+  }
+  intr_set_level(old_level);
+}
+
+/* Releases RW, which the current thread holds for writing. */
+void rwlock_write_release(struct rwlock *rw) {
+  ASSERT(rw != NULL);
+
+  lock_release(&rw->lock);
+}
+
+/* One semaphore in a condition variable's wait heap. */
 struct semaphore_elem {
-  struct list_elem elem;      /* List element. */
+  struct heap_elem elem;      /* Heap element. */
   struct semaphore semaphore; /* This semaphore. */
+  struct thread *thread;      /* Waiting thread, whose priority is the key. */
+  struct condition *cond;     /* Condition variable waited on. */
 };
 
+/* Orders condition variable waiters by the waiting thread's
+   priority. */
+static bool cond_waiter_less(const struct heap_elem *a, const struct heap_elem *b, void *aux UNUSED) {
+  return heap_entry(a, struct semaphore_elem, elem)->thread->priority <
+         heap_entry(b, struct semaphore_elem, elem)->thread->priority;
+}
+
+/* heap_apply() action: brings a condition variable waiter's MLFQS
+   priority up to date. */
+static void cond_waiter_refresh(struct heap_elem *e, void *aux UNUSED) {
+  thread_mlfqs_refresh(heap_entry(e, struct semaphore_elem, elem)->thread);
+}
+
+/* Re-keys WAITER after its thread's priority changed. */
+static void cond_waiter_update(struct semaphore_elem *waiter) {
+  heap_update(&waiter->cond->waiters, &waiter->elem);
+}
+
 /* Initializes condition variable COND.  A condition variable
    allows one piece of code to signal a condition and cooperating
    code to receive the signal and act upon it. */
 void cond_init(struct condition *cond) {
   ASSERT(cond != NULL);
 
-  list_init(&cond->waiters);
+  heap_init(&cond->waiters, cond_waiter_less, NULL);
 }
 
 /* Atomically releases LOCK and waits for COND to be signaled by
@@ -350,8 +636,16 @@ void cond_wait(struct condition *cond, struct lock *lock) {  // 특정 조건에
   ASSERT(!intr_context());
   ASSERT(lock_held_by_current_thread(lock));
 
-  sema_init(&waiter.semaphore, 0);               // 새로만든 semaphore_elem을 초기화한다.
-  list_push_back(&cond->waiters, &waiter.elem);  // 새로만든 semaphore 를 cond에 추가한다.
+  sema_setup(&waiter.semaphore, 0);  // 새로만든 semaphore_elem을 초기화한다.
+  waiter.thread = thread_current();
+  waiter.cond = cond;
+
+  // 새로만든 semaphore 를 cond에 추가한다. donation으로 재정렬될 수 있으니 인터럽트를 끄고
+  enum intr_level old_level = intr_disable();
+  heap_push(&cond->waiters, &waiter.elem);
+  waiter.thread->cond_waiter = &waiter;
+  intr_set_level(old_level);
+
   lock_release(lock);  // 다른 사람이 들어올 수 있도록 lock을 열어 둔다(원자적 이동을 보장하기 위함)
   sema_down(&waiter.semaphore);  // 내 전용 semaphore가 풀릴 때까지 대기한다.(cond_signal이 풀어줌)
   lock_acquire(lock);            // 다른 스레드의 배타적 접근을 위해서 대기
@@ -370,32 +664,18 @@ void cond_signal(struct condition *cond, struct lock *lock UNUSED) {  // 조건
   ASSERT(!intr_context());
   ASSERT(lock_held_by_current_thread(lock));
 
-  if (!list_empty(&cond->waiters)) {
-    struct list_elem *max_elem = NULL;
-    int max_priority = -1;
-
-    // for문으로 가장 높은 우선순위 찾기
-    struct list_elem *e;
-    for (e = list_begin(&cond->waiters); e != list_end(&cond->waiters); e = list_next(e)) {
-      struct semaphore_elem *sema_elem = list_entry(e, struct semaphore_elem, elem);
-
-      // list_front 쓰기전에 원소가 있는지 없는지 먼저 확인할 것
-      if (list_empty(&sema_elem->semaphore.waiters)) continue;
-
-      // 대기 중인 쓰레드 중에서 가장 우선순위가 높은 쓰레드를 찾는다.
-      struct thread *waiting_thread = list_entry(list_front(&sema_elem->semaphore.waiters), struct thread, elem);
-      if (waiting_thread->priority > max_priority) {
-        max_priority = waiting_thread->priority;
-        max_elem = e;
-      }
-    }
-    if (max_elem != NULL) {  // 가장 우선순위 높은 쓰레드를 깨운다.
-      struct semaphore_elem *max_sema_elem = list_entry(max_elem, struct semaphore_elem, elem);
-      list_remove(max_elem);
-      // 해당 조건을 기다리는건 그 쓰레드 전용 semaphore를 기다리는 것으로 구현했으므로 semaphore를 풀어준다.
-      sema_up(&max_sema_elem->semaphore);
-    }
+  enum intr_level old_level = intr_disable();
+  if (!heap_empty(&cond->waiters)) {
+    // mlfqs: 잠든 동안 갱신되지 않은 대기자들의 priority를 먼저 최신화
+    if (thread_mlfqs) heap_apply(&cond->waiters, cond_waiter_refresh, NULL);
+
+    // 가장 우선순위 높은 쓰레드를 깨운다. 힙의 top, O(log n)
+    struct semaphore_elem *waiter = heap_entry(heap_pop(&cond->waiters), struct semaphore_elem, elem);
+    waiter->thread->cond_waiter = NULL;
+    // 해당 조건을 기다리는건 그 쓰레드 전용 semaphore를 기다리는 것으로 구현했으므로 semaphore를 풀어준다.
+    sema_up(&waiter->semaphore);
   }
+  intr_set_level(old_level);
 }
 
 /* Wakes up all threads, if any, waiting on COND (protected by
@@ -408,5 +688,5 @@ void cond_broadcast(struct condition *cond, struct lock *lock) {
   ASSERT(cond != NULL);
   ASSERT(lock != NULL);
 
-  while (!list_empty(&cond->waiters)) cond_signal(cond, lock);
+  while (!heap_empty(&cond->waiters)) cond_signal(cond, lock);
 }
@@ -6,13 +6,19 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "devices/timer.h"
 #include "intrinsic.h"
 #include "threads/fixed-point.h"
 #include "threads/flags.h"
+#include "threads/init.h"
 #include "threads/interrupt.h"
 #include "threads/intr-stubs.h"
+#include "threads/mmu.h"
 #include "threads/palloc.h"
+#include "threads/profile.h"
+#include "threads/switch.h"
 #include "threads/synch.h"
+#include "threads/trace.h"
 #include "threads/vaddr.h"
 
 #ifdef USERPROG
@@ -28,15 +34,30 @@
    Do not modify this value. */
 #define THREAD_BASIC 0xd42df210
 
-/* List of processes in THREAD_READY state, that is, processes
-   that are ready to run but not actually running. */
-static struct list ready_list;
-static struct list sleep_list;  // sleep_list를 관리할 이중 연결리스트 생성
-static struct list all_list;    // 모든 스레드를 관리함
+/* Run queue of processes in THREAD_READY state, that is, processes
+   that are ready to run but not actually running.  One FIFO list per
+   priority level; bit P of ready_bitmap is set iff ready_queues[P]
+   is non-empty, so the highest ready priority is a single bsr.
+   Shared by the priority scheduler and the MLFQS.
+
+   Under the CFS (-cfs) the run queue is instead a red-black tree
+   of ready threads ordered by vruntime, and the ready_queues are
+   left empty.
+
+   Real-time threads (thread_set_deadline()) sit in a separate
+   tree ordered by absolute deadline, which is always served
+   first, whatever the scheduler.  Those that have used up their
+   budget wait on dl_throttled until it is replenished. */
+static struct list ready_queues[PRI_MAX - PRI_MIN + 1];
+static uint64_t ready_bitmap;
+static int ready_threads_count;  // run queue에 들어있는 쓰레드 수
+static struct rb_tree cfs_tree;  // CFS: vruntime 순 ready 쓰레드
+static uint64_t min_vruntime;    // CFS: 단조 증가하는 vruntime 하한
+static uint64_t cfs_load;        // CFS: cfs_tree의 가중치 합
+static struct rb_tree edf_tree;  // EDF: deadline 순 ready 쓰레드
+static struct list dl_throttled; // EDF: budget 소진, replenish 대기
 
-/* MLQFS 전용 다중 큐*/
-static struct list mlfqs_ready_queues[PRI_MAX - PRI_MIN + 1];
-static int ready_threads_count;
+static struct list all_list;    // 모든 스레드를 관리함
 
 /* Idle thread. */
 static struct thread *idle_thread;
@@ -50,6 +71,24 @@ static struct lock tid_lock;
 /* Thread destruction requests */
 static struct list destruction_req;
 
+/* Pages of dead threads are kept in a small cache, linked
+   through their `elem', and handed to the next thread_create()
+   as they are: only the struct thread header is reinitialized,
+   so a create/exit pair costs neither a trip through the page
+   allocator nor a 4 kB memset.  THREAD_CACHE_MAX bounds how much
+   memory the cache may hold on to. */
+#define THREAD_CACHE_MAX 8
+static struct list thread_cache;
+static size_t thread_cache_cnt;
+static long long thread_cache_hits;   /* # of thread pages reused. */
+static long long thread_cache_misses; /* # of thread pages allocated. */
+
+/* If true, every thread page is preceded by an unmapped guard
+   page, so that a kernel stack that runs past its struct thread
+   faults at once instead of silently corrupting the page below.
+   Controlled by kernel command-line option "-stack-guard". */
+bool thread_stack_guard;
+
 /* Statistics. */
 static long long idle_ticks;   /* # of timer ticks spent idle. */
 static long long kernel_ticks; /* # of timer ticks in kernel threads. */
@@ -58,15 +97,83 @@ static long long user_ticks;   /* # of timer ticks in user programs. */
 /* mlfqs global variables */
 static fixed_t load_avg; /* 시스템 부하 평균 (fixed-point) */
 
+/* Lazy recent_cpu decay.  Each second is an "epoch" whose decay
+   coefficient 2*load_avg/(2*load_avg+1) is remembered here; a
+   blocked thread is not touched at the epoch but catches up on the
+   coefficients it missed when it becomes runnable again (see
+   thread_mlfqs_refresh()).  Only the last DECAY_HISTORY epochs are
+   kept. */
+#define DECAY_HISTORY 64
+static fixed_t decay_coef[DECAY_HISTORY]; /* epoch e의 계수는 [e % DECAY_HISTORY] */
+static int64_t decay_epoch;               /* 부팅 후 지난 epoch(초) 수 */
+static int decay_last_visited;            /* 마지막 epoch에서 갱신한 쓰레드 수 */
+
 /* Scheduling. */
 #define TIME_SLICE 4          /* # of timer ticks to give each thread. */
 static unsigned thread_ticks; /* # of timer ticks since last yield. */
 
+/* Adaptive time slices (-adaptive), for the priority scheduler.
+   Priorities fall into ADAPT_BANDS equal bands, each with its own
+   base slice in adapt_quantum[].  A thread's adapt_score rises
+   when it blocks having used less than half of its slice and
+   falls when it runs its slice out, within +-ADAPT_SCORE_MAX.  A
+   positive score queues the thread adapt_score / 2 levels above
+   its priority, so threads that mostly wait (console, I/O) run as
+   soon as they wake; a negative one doubles the slice from
+   ADAPT_STRETCH points below zero and quadruples it from twice
+   that, so CPU-bound threads are switched less often. */
+bool thread_adaptive;
+
+#define ADAPT_BANDS 3
+#define ADAPT_SCORE_MAX 8
+#define ADAPT_STRETCH 3
+static unsigned adapt_quantum[ADAPT_BANDS] = {8, 4, 2}; /* 낮은 대역일수록 길게 */
+
 /* If false (default), use round-robin scheduler.
    If true, use multi-level feedback queue scheduler.
    Controlled by kernel command-line option "-o mlfqs". */
 bool thread_mlfqs;
 
+/* Completely fair scheduler (-cfs).  Each thread accumulates
+   vruntime, its CPU time in nanoseconds scaled by NICE_0_WEIGHT /
+   weight, measured with timer_now_ns() rather than in ticks; the
+   ready thread with the least vruntime runs next.  Every thread
+   gets a share of each CFS_LATENCY_NS period proportional to its
+   weight, but runs at least CFS_MIN_GRAN_NS once picked.  A
+   waking thread preempts the running one if its vruntime is at
+   least CFS_WAKEUP_GRAN_NS smaller, and is credited at most
+   CFS_LATENCY_NS / 2 for the time it slept. */
+bool thread_cfs;
+
+#define CFS_LATENCY_NS 20000000ULL   /* 20 ms. */
+#define CFS_MIN_GRAN_NS 4000000ULL   /* 4 ms. */
+#define CFS_WAKEUP_GRAN_NS 1000000ULL /* 1 ms. */
+#define NICE_0_WEIGHT 1024
+
+/* Earliest deadline first (thread_set_deadline()).  A real-time
+   thread is guaranteed RUNTIME ns of CPU in every PERIOD, within
+   DEADLINE ns of the period's start, as long as the total
+   bandwidth sum(RUNTIME / PERIOD) stays below EDF_BW_MAX per CPU;
+   thread_set_deadline() refuses reservations beyond that.  The
+   running thread is charged in update_curr() and, once its budget
+   for the period is spent, throttled until the next period
+   (constant bandwidth server, [Abeni98]).  Bandwidth is kept in
+   EDF_BW_SHIFT-bit fixed point. */
+#define EDF_BW_SHIFT 20
+#define EDF_BW_MAX ((95ULL << EDF_BW_SHIFT) / 100) /* 95%. */
+#define NS_PER_TICK (1000000000 / TIMER_FREQ)
+static uint64_t dl_total_bw; /* 허가된 예약들의 bandwidth 합 */
+
+/* CFS weight of each nice value from -20 to 20.  Successive
+   values differ by about 1.25x, so one nice level moves about 10%
+   of the CPU between two competing threads. */
+static const uint32_t nice_to_weight[41] = {
+    88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916, 9548,
+    7620,  6100,  4904,  3906,  3121,  2501,  1991,  1586,  1277,  1024, 820,
+    655,   526,   423,   335,   272,   215,   172,   137,   110,   87,   70,
+    56,    45,    36,    29,    23,    18,    15,    12,
+};
+
 static void kernel_thread(thread_func *, void *aux);
 
 static void idle(void *aux UNUSED);
@@ -75,7 +182,27 @@ static void init_thread(struct thread *, const char *name, int priority);
 static void do_schedule(int status);
 static void schedule(void);
 static tid_t allocate_tid(void);
-static void thread_update_recent_cpu(struct thread *t);
+static fixed_t decay_power(fixed_t coef, int64_t n);
+static void ready_queue_push(struct thread *t);
+static void ready_queue_remove(struct thread *t);
+static struct thread *ready_queue_pop(void);
+static uint32_t cfs_weight(const struct thread *t);
+static bool cfs_less(const struct rb_elem *a, const struct rb_elem *b, void *aux);
+static void update_curr(void);
+static int sched_priority(const struct thread *t);
+static unsigned thread_quantum(const struct thread *t);
+static bool preempts_curr(struct thread *t);
+static void cfs_update_min(void);
+static bool cfs_preempts_curr(struct thread *t);
+static bool edf_less(const struct rb_elem *a, const struct rb_elem *b, void *aux);
+static uint64_t edf_bw(const struct thread *t);
+static void edf_wakeup(struct thread *t);
+static void edf_throttle(struct thread *t);
+static void edf_replenish(void *t_);
+static void edf_leave(struct thread *t);
+static struct thread *thread_page_alloc(void);
+static void thread_page_free(struct thread *t);
+static void thread_page_release(struct thread *t);
 
 /* Returns true if T appears to point to a valid thread. */
 #define is_thread(t) ((t) != NULL && (t)->magic == THREAD_MAGIC)
@@ -116,8 +243,13 @@ void thread_init(void) {
 
   /* Init the global thread context */
   lock_init(&tid_lock);
-  list_init(&ready_list);
-  list_init(&sleep_list);
+  for (int i = PRI_MIN; i <= PRI_MAX; i++) list_init(&ready_queues[i - PRI_MIN]);
+  ready_bitmap = 0;
+  ready_threads_count = 0;
+  rb_init(&cfs_tree, cfs_less, NULL);
+  rb_init(&edf_tree, edf_less, NULL);
+  list_init(&dl_throttled);
+  list_init(&thread_cache);
   list_init(&all_list);
   list_init(&destruction_req);
 
@@ -131,24 +263,24 @@ void thread_init(void) {
   initial_thread->tid = allocate_tid();
   list_push_front(&all_list, &initial_thread->all_elem);
 
-  if (thread_mlfqs) {
+  if (thread_mlfqs)
     mlfqs_update_priority(
         initial_thread);  // 첫 main쓰레드 priority 설정(PRI_MAX)
-
-    // mlfqs_ready_queues에는 PRI_MIN을 시작으로 PRI_MAX까지 우선순위별 다중
-    // 큐임
-    for (int i = PRI_MIN; i <= PRI_MAX; i++) {
-      list_init(&mlfqs_ready_queues[i - PRI_MIN]);
-    }
-    ready_threads_count = 0;  // 0으로 초기화
-
-  } else
+  else if (thread_cfs)
+    printf("CFS scheduler enabled\n");
+  else
     printf("Priority scheduler enabled\n");
+  if (thread_adaptive)
+    printf("Adaptive time slices: %u/%u/%u ticks (low/mid/high)\n",
+           adapt_quantum[0], adapt_quantum[1], adapt_quantum[2]);
 }
 
 /* Starts preemptive thread scheduling by enabling interrupts.
    Also creates the idle thread. */
 void thread_start(void) {
+  trace_init(1);
+  profile_init(1);
+
   /* Create the idle thread. */
   struct semaphore idle_started;
   sema_init(&idle_started, 0);
@@ -176,13 +308,113 @@ void thread_tick(void) {
     kernel_ticks++;
 
   /* Enforce preemption. */
-  if (++thread_ticks >= TIME_SLICE) intr_yield_on_return();
+  if (t->dl_period != 0) {
+    // EDF: 더 이른 deadline이 깨어나거나 budget을 다 쓸 때까지 실행
+    update_curr();
+    if (t->dl_throttled) intr_yield_on_return();
+    return;
+  }
+  if (thread_cfs) {
+    // CFS: 가중치 비례 몫을 다 썼고 기다리는 쓰레드가 있으면 양보
+    if (t == idle_thread || ready_threads_count == 0) return;
+    update_curr();
+
+    uint64_t nr = ready_threads_count + 1;
+    uint64_t period = nr * CFS_MIN_GRAN_NS > CFS_LATENCY_NS ? nr * CFS_MIN_GRAN_NS : CFS_LATENCY_NS;
+    uint64_t slice = period * cfs_weight(t) / (cfs_load + cfs_weight(t));
+    if (slice < CFS_MIN_GRAN_NS) slice = CFS_MIN_GRAN_NS;
+    if (t->slice_exec >= slice) intr_yield_on_return();
+    return;
+  }
+  if (++thread_ticks >= thread_quantum(t)) {
+    // slice를 다 썼으면 CPU 위주 쪽으로
+    if (thread_adaptive && thread_ticks == thread_quantum(t) &&
+        t->adapt_score > -ADAPT_SCORE_MAX)
+      t->adapt_score--;
+    intr_yield_on_return();
+  }
+}
+
+/* Sets up adaptive time slices.  QUANTA, if non-null, gives the
+   base slice in ticks of the low, middle and high priority bands,
+   as in "8,4,2".  Returns false if QUANTA is malformed. */
+bool thread_set_adaptive(const char *quanta) {
+  thread_adaptive = true;
+  if (quanta == NULL) return true;
+
+  for (int i = 0; i < ADAPT_BANDS; i++) {
+    int q = 0;
+    if (*quanta < '0' || *quanta > '9') return false;
+    while (*quanta >= '0' && *quanta <= '9') q = q * 10 + (*quanta++ - '0');
+    if (q == 0) return false;
+    adapt_quantum[i] = q;
+    if (i < ADAPT_BANDS - 1 && *quanta++ != ',') return false;
+  }
+  return *quanta == '\0';
+}
+
+/* Returns the level of the run queue T goes on: its priority,
+   raised by the adaptive interactivity boost. */
+static int sched_priority(const struct thread *t) {
+  int priority = t->priority;
+  if (thread_adaptive && t->adapt_score > 0) {
+    priority += t->adapt_score / 2;
+    if (priority > PRI_MAX) priority = PRI_MAX;
+  }
+  return priority;
+}
+
+/* Returns T's time slice in ticks. */
+static unsigned thread_quantum(const struct thread *t) {
+  if (!thread_adaptive) return TIME_SLICE;
+
+  unsigned q = adapt_quantum[(t->priority - PRI_MIN) * ADAPT_BANDS / (PRI_MAX - PRI_MIN + 1)];
+  if (t->adapt_score <= -2 * ADAPT_STRETCH)
+    q *= 4;
+  else if (t->adapt_score <= -ADAPT_STRETCH)
+    q *= 2;
+  return q;
 }
 
 /* Prints thread statistics. */
 void thread_print_stats(void) {
   printf("Thread: %lld idle ticks, %lld kernel ticks, %lld user ticks\n",
          idle_ticks, kernel_ticks, user_ticks);
+  printf("Thread cache: %lld hits, %lld misses\n", thread_cache_hits,
+         thread_cache_misses);
+}
+
+/* Charges the time since the last mode switch to the running
+   thread's user time.  Called on entry to the kernel from user
+   mode. */
+void thread_ru_enter_kernel(void) {
+  struct thread *t = thread_current();
+  enum intr_level old_level = intr_disable();
+  uint64_t now = timer_now_ns();
+  t->ru.utime_ns += now - t->ru_stamp;
+  t->ru_stamp = now;
+  intr_set_level(old_level);
+}
+
+/* Charges the time since the last mode switch to the running
+   thread's system time.  Called just before returning to user
+   mode. */
+void thread_ru_leave_kernel(void) {
+  struct thread *t = thread_current();
+  enum intr_level old_level = intr_disable();
+  uint64_t now = timer_now_ns();
+  t->ru.stime_ns += now - t->ru_stamp;
+  t->ru_stamp = now;
+  intr_set_level(old_level);
+}
+
+/* Stores T's resource usage in RU.  For the running thread, the
+   system time includes the current stay in the kernel. */
+void thread_get_rusage(struct thread *t, struct rusage *ru) {
+  enum intr_level old_level = intr_disable();
+  *ru = t->ru;
+  if (t == thread_current()) ru->stime_ns += timer_now_ns() - t->ru_stamp;
+  intr_set_level(old_level);
 }
 
 /* Creates a new kernel thread named NAME with the given initial
@@ -208,7 +440,7 @@ tid_t thread_create(const char *name, int priority, thread_func *function,
   ASSERT(function != NULL);
 
   /* Allocate thread. */
-  t = palloc_get_page(PAL_ZERO);
+  t = thread_page_alloc();
   if (t == NULL) return TID_ERROR;
 
   /* Initialize thread. */
@@ -225,6 +457,11 @@ tid_t thread_create(const char *name, int priority, thread_func *function,
     }
     mlfqs_update_priority(t);  // priority 공식으로 계산
   }
+  if (thread_cfs) {
+    // 새 쓰레드는 현재 가장 뒤처진 쓰레드와 같은 위치에서 시작
+    t->nice = thread_current()->nice;
+    t->vruntime = min_vruntime;
+  }
 
   /* Call the kernel_thread if it scheduled.
    * Note) rdi is 1st argument, and rsi is 2nd argument. */
@@ -237,6 +474,14 @@ tid_t thread_create(const char *name, int priority, thread_func *function,
   t->tf.cs = SEL_KCSEG;
   t->tf.eflags = FLAG_IF;
 
+  /* The first switch to T "returns" into switch_entry, which
+   * launches it through do_iret. */
+  struct switch_threads_frame *sf =
+      (struct switch_threads_frame *)(t->tf.rsp - sizeof *sf);
+  sf->rbx = (uint64_t)&t->tf;
+  sf->rip = switch_entry;
+  t->stack = (uint64_t)sf;
+
   /* Add to run queue. */
   thread_unblock(t);
 
@@ -252,10 +497,57 @@ tid_t thread_create(const char *name, int priority, thread_func *function,
 void thread_block(void) {
   ASSERT(!intr_context());
   ASSERT(intr_get_level() == INTR_OFF);
-  thread_current()->status = THREAD_BLOCKED;
+  update_curr();
+  trace_block(thread_current(), __builtin_return_address(0));
+
+  // slice를 반도 안 쓰고 잠들면 interactive 쪽으로
+  struct thread *curr = thread_current();
+  if (thread_adaptive && curr != idle_thread &&
+      thread_ticks * 2 < thread_quantum(curr) &&
+      curr->adapt_score < ADAPT_SCORE_MAX)
+    curr->adapt_score++;
+
+  curr->status = THREAD_BLOCKED;
   schedule();
 }
 
+/* thread_block() for a wait that thread_interrupt() may cut
+   short.  Returns false at once, without blocking, if the running
+   thread has already been interrupted, and true once it has been
+   woken, whether by the event it waits for or by
+   thread_interrupt().  The caller must check which, and undo its
+   wait if the event has not happened.  If the thread is queued
+   on a semaphore (wait_heap), thread_interrupt() takes it off. */
+bool thread_block_interruptible(void) {
+  struct thread *curr = thread_current();
+
+  ASSERT(intr_get_level() == INTR_OFF);
+  if (curr->interrupted) return false;
+  curr->interruptible = true;
+  thread_block();
+  curr->interruptible = false;
+  return true;
+}
+
+/* Interrupts thread T: wakes it if it is blocked in
+   thread_block_interruptible(), and makes every interruptible
+   wait it starts from now on fail at once.  Used to stop the
+   threads of an exiting process. */
+void thread_interrupt(struct thread *t) {
+  enum intr_level old_level = intr_disable();
+
+  ASSERT(is_thread(t));
+  t->interrupted = true;
+  if (t->status == THREAD_BLOCKED && t->interruptible) {
+    if (t->wait_heap != NULL) {  // 세마포어 대기 힙에서 빼낸다
+      heap_remove(t->wait_heap, &t->wait_elem);
+      t->wait_heap = NULL;
+    }
+    thread_unblock(t);
+  }
+  intr_set_level(old_level);
+}
+
 /* Transitions a blocked thread T to the ready-to-run state.
    This is an error if T is not blocked.  (Use thread_yield() to
    make the running thread ready.)
@@ -275,19 +567,20 @@ void thread_unblock(struct thread *t) {
       t->status ==
       THREAD_BLOCKED);  // 해당 쓰레드의 status 필드가 THREAD_BLOCKED인지 확인
 
-  if (thread_mlfqs) {
-    list_push_back(&mlfqs_ready_queues[t->priority - PRI_MIN],
-                   &t->elem);  // 우선순위에 맞는 큐에 집어넣음
-    if (t != idle_thread)      // idle thread는 카운트 하면 안되므로
-      ready_threads_count++;
-  } else {
-    list_insert_ordered(&ready_list, &t->elem, thread_priority_less,
-                        NULL);  // 우선순위 큰 순서대로 삽입
+  thread_mlfqs_refresh(t);   // 잠든 동안 놓친 recent_cpu 감쇠 반영
+  if (thread_cfs) {
+    // 오래 잠들었어도 min_vruntime보다 반 period 이상 앞서지 못하게
+    uint64_t floor = min_vruntime;
+    floor = floor > CFS_LATENCY_NS / 2 ? floor - CFS_LATENCY_NS / 2 : 0;
+    if (t->vruntime < floor) t->vruntime = floor;
   }
+  if (t->dl_period != 0 && !t->dl_throttled) edf_wakeup(t);
+  trace_wakeup(t);
+  ready_queue_push(t);       // 우선순위에 맞는 큐의 맨 뒤에 집어넣음
   t->status = THREAD_READY;  // 해당 쓰레드의 상태를 THREAD_READY로 바꿈
 
   // 인터럽트끝나고 보내야할 경우에
-  if (t->priority > thread_current()->priority) {
+  if (preempts_curr(t)) {
     if (intr_context()) {
       // 인터럽트 핸들러 내부: 나중에 yield
       intr_yield_on_return();
@@ -324,6 +617,10 @@ struct thread *thread_current(void) {
 /* Returns the running thread's tid. */
 tid_t thread_tid(void) { return thread_current()->tid; }
 
+/* Returns the index of the CPU we are running on.  Only the
+   bootstrap processor is started, so this is always 0. */
+int thread_cpu_id(void) { return 0; }
+
 /* Deschedules the current thread and destroys it.  Never
    returns to the caller. */
 void thread_exit(void) {
@@ -337,6 +634,7 @@ void thread_exit(void) {
      We will be destroyed during the call to schedule_tail(). */
   intr_disable();
   list_remove(&thread_current()->all_elem);  // all_list에서 제거
+  edf_leave(thread_current());               // 예약 반납, replenish 타이머 해제
   do_schedule(THREAD_DYING);
   NOT_REACHED();
 }
@@ -350,32 +648,16 @@ void thread_yield(void) {  // 현재 스레드가 가장 높은 우선순위를
 
   enum intr_level old_level = intr_disable();
   if (curr != idle_thread) {
-    if (thread_mlfqs) {  // mlfqs 모드인 경우
-      int max_priority = max_priority_mlfqs_queue();
-      if (max_priority >= 0) {  // 전체 큐가 비어있지 않은 경우
-        if (curr->priority > max_priority) {
-          intr_set_level(old_level);
-          return;
-        }
-      }
-      list_push_back(&mlfqs_ready_queues[curr->priority - PRI_MIN],
-                     &curr->elem);  // 본인 우선순위에 맞는 레디큐로 들어감
-      ready_threads_count++;
-    } else {
-      if (!list_empty(&ready_list)) {
-        struct thread *highest =
-            list_entry(list_front(&ready_list), struct thread, elem);
-
-        if (curr->priority >
-            highest->priority) {  // 현재 쓰레드가 ready_list에 있는
-                                  // 쓰레드들보다 우선순위가 높다면
-          intr_set_level(old_level);
-          return;  // yield를 할 필요가 없음.
-        }
-      }
-      list_insert_ordered(&ready_list, &curr->elem, thread_priority_less,
-                          NULL);  // 우선순위 순으로 정렬하며 삽입
+    update_curr();  // 지금까지 쓴 시간을 반영 (CFS vruntime, EDF budget)
+
+    // 현재 쓰레드가 run queue에 있는 쓰레드들보다 우선순위가 높다면
+    // yield를 할 필요가 없음. (큐가 비어있으면 -1)
+    if (!thread_cfs && curr->dl_period == 0 && rb_empty(&edf_tree) &&
+        sched_priority(curr) > thread_max_ready_priority()) {
+      intr_set_level(old_level);
+      return;
     }
+    ready_queue_push(curr);  // 본인 우선순위에 맞는 레디큐로 들어감
   }
   do_schedule(THREAD_READY);
   intr_set_level(old_level);
@@ -388,44 +670,51 @@ void thread_set_priority(int new_priority) {
   struct thread *curr = thread_current();
   int old_priority = curr->priority;
 
-  // donate를 안받은 경우에는 priority를 바꿔주어야 함. // lock_release에서
-  // 적당한 priority로 바꿔 줄거라서
-  if (curr->is_donated == 0) curr->priority = new_priority;
+  enum intr_level old_level = intr_disable();
   curr->original_priority = new_priority;
-  if (old_priority > new_priority) {  // 만약 우선순위가 더 낮아졌고,
-                                      // ready_list에 원소가 있을 떄
+  lock_refresh_priority(curr);  // 기부받는 중이라면 기부받은 값이 유지됨
+  intr_set_level(old_level);
+  if (curr->priority < old_priority) {  // 실제 우선순위가 더 낮아졌을 때
     thread_yield();  // yield를 통해 뒤로 보냄
   }
 }
-// thread_update_all_priority 생성해야함
-void thread_update_all_priority(void) {
+/* Starts a new MLFQS epoch: records this second's recent_cpu decay
+   coefficient and brings the running and ready threads up to date.
+   Blocked threads are left alone until thread_mlfqs_refresh() is
+   called on them, so the work done here with interrupts off is
+   proportional to the number of runnable threads only.  Called
+   once per second, after thread_update_load_avg(). */
+void thread_mlfqs_decay(void) {
   enum intr_level old_level = intr_disable();  // 인터럽트 끄기
-  struct list_elem *e;  // all_list 순회 시 사용하는 iterator
-  struct list
-      new_ready_queue;  // ready 큐 임시 저장(싹다 뺐다가 싹다 넣을 거임)
-  list_init(&new_ready_queue);  // new_ready 큐 초기화
-
-  /* all list 순회하며 priority 갱신 */
-  for (e = list_begin(&all_list); e != list_end(&all_list); e = list_next(e)) {
-    struct thread *t = list_entry(e, struct thread, all_elem);
-    if (t == idle_thread) continue;   // idle 쓰레드는 제외
-    if (t->status == THREAD_READY) {  // ready queue에 있던 thread라면
-      list_remove(&t->elem);          // 기존에 있던 ready queue에서 빼고
-      list_push_back(&new_ready_queue, &t->elem);  // 임시 저장 큐에 집어넣기
-    }
-    mlfqs_update_priority(t);  // priority 조정
+  struct thread *curr = thread_current();
+  struct list runnable;  // ready 큐에서 잠시 빼둘 쓰레드들
+  int visited = 0;
+
+  decay_epoch++;
+  decay_coef[decay_epoch % DECAY_HISTORY] =
+      DIV_FP(MULT_FP_INT(load_avg, 2), ADD_FP_INT(MULT_FP_INT(load_avg, 2), 1));
+
+  if (curr != idle_thread) {
+    thread_mlfqs_refresh(curr);
+    visited++;
   }
 
-  // ready 큐들은 다시 다중 큐에 집어 넣기
-  while (!list_empty(&new_ready_queue)) {
-    e = list_pop_front(&new_ready_queue);
-    struct thread *t = list_entry(e, struct thread, elem);
-    list_push_back(&mlfqs_ready_queues[t->priority - PRI_MIN], e);
+  /* ready 큐를 비우고 갱신한 뒤 새 우선순위의 큐로 다시 넣는다 */
+  list_init(&runnable);
+  for (struct thread *t; (t = ready_queue_pop()) != NULL;) list_push_back(&runnable, &t->elem);
+  while (!list_empty(&runnable)) {
+    struct thread *t = list_entry(list_pop_front(&runnable), struct thread, elem);
+    if (t != idle_thread) {  // idle 쓰레드는 제외
+      thread_mlfqs_refresh(t);
+      visited++;
+    }
+    ready_queue_push(t);
   }
+  decay_last_visited = visited;
 
-  // 혹시 현재 스레드의 우선순위가 레디큐에 있는 쓰레드보다 작거나 같다면
+  // 혹시 현재 스레드의 우선순위가 레디큐에 있는 쓰레드보다 작다면
   // 양보해야함
-  if (thread_current()->priority < max_priority_mlfqs_queue()) {
+  if (thread_current()->priority < thread_max_ready_priority()) {
     if (intr_context()) {
       intr_yield_on_return();
     } else {
@@ -437,6 +726,43 @@ void thread_update_all_priority(void) {
 
   intr_set_level(old_level);  // 인터럽트 복원
 }
+/* Applies to T's recent_cpu every epoch decay it has missed, then
+   recomputes its priority.  Cheap no-op for a thread that is up
+   to date, which every running or ready thread is.  T must not be
+   in the run queue, since its priority may change. */
+void thread_mlfqs_refresh(struct thread *t) {
+  ASSERT(intr_get_level() == INTR_OFF);
+  if (!thread_mlfqs || t->decay_epoch == decay_epoch) return;
+
+  int64_t missed = decay_epoch - t->decay_epoch;
+
+  /* history보다 오래 잠들어 있었다면, 기록이 없는 앞쪽 epoch들은
+     가장 오래된 계수 c로 근사한다:
+     rc' = c^k * rc + nice * (1 - c^k) / (1 - c) */
+  if (missed > DECAY_HISTORY) {
+    int64_t k = missed - DECAY_HISTORY;
+    fixed_t c = decay_coef[(decay_epoch + 1) % DECAY_HISTORY];
+    fixed_t ck = decay_power(c, k);
+
+    t->recent_cpu = ADD_FP(MULT_FP(ck, t->recent_cpu),
+                           MULT_FP_INT(DIV_FP(SUB_FP(INT_TO_FP(1), ck),
+                                              SUB_FP(INT_TO_FP(1), c)),
+                                       t->nice));
+    missed = DECAY_HISTORY;
+  }
+
+  /* recent_cpu = load_avg * 2 / (load_avg * 2 + 1) * recent_cpu  + nice */
+  for (int64_t e = decay_epoch - missed + 1; e <= decay_epoch; e++)
+    t->recent_cpu = ADD_FP_INT(
+        MULT_FP(decay_coef[e % DECAY_HISTORY], t->recent_cpu), t->nice);
+  t->decay_epoch = decay_epoch;
+  mlfqs_update_priority(t);
+}
+
+/* Returns the number of threads brought up to date by the last
+   thread_mlfqs_decay(). */
+int thread_mlfqs_last_visited(void) { return decay_last_visited; }
+
 void mlfqs_update_priority(struct thread *t) {
   if (!thread_mlfqs) return;  // mlqfs 가 아니라면 나가라
 
@@ -474,6 +800,7 @@ void thread_set_nice(int nice) {
   enum intr_level old_level = intr_disable();
   // 현재 스레드의 nice 값 업데이트
   struct thread *curr = thread_current();
+  update_curr();  // 지금까지는 이전 가중치로 계산
   curr->nice = nice;
   // 자신의 priority 재계산
   mlfqs_update_priority(curr);
@@ -481,7 +808,7 @@ void thread_set_nice(int nice) {
   // 만약 자신이 더 이상 최고 priority가 아니면 양보
   /* 조건보고 양보하는 경우 (다른 쓰레드에 의해서 race 발생해서 max가 바뀔수도
    * 있음)*/
-  if (curr->priority < max_priority_mlfqs_queue()) {
+  if (curr->priority < thread_max_ready_priority()) {
     if (intr_context()) {
       intr_yield_on_return();
     } else {
@@ -493,6 +820,55 @@ void thread_set_nice(int nice) {
   intr_set_level(old_level);
 }
 
+/* Makes the current thread a real-time thread that needs RUNTIME
+   ns of CPU time in every PERIOD ns, finished within DEADLINE ns
+   of the start of each period; such threads run ahead of all
+   others, earliest deadline first.  A thread that runs past its
+   RUNTIME is held off the CPU until its next period.  PERIOD 0
+   returns the thread to its normal scheduling class.
+
+   Returns false, changing nothing, if the parameters are invalid
+   (0 < RUNTIME <= DEADLINE <= PERIOD is required) or if admitting
+   the reservation would commit more than 95% of the CPUs. */
+bool thread_set_deadline(int64_t period, int64_t runtime, int64_t deadline) {
+  struct thread *curr = thread_current();
+  enum intr_level old_level;
+
+  ASSERT(!intr_context());
+
+  if (period == 0) {
+    old_level = intr_disable();
+    update_curr();
+    edf_leave(curr);
+    intr_set_level(old_level);
+    thread_yield();
+    return true;
+  }
+  if (runtime <= 0 || runtime > deadline || deadline > period) return false;
+
+  old_level = intr_disable();
+  uint64_t bw = ((uint64_t)runtime << EDF_BW_SHIFT) / period;
+  uint64_t old_bw = curr->dl_period != 0 ? edf_bw(curr) : 0;
+  // admission control: 총 bandwidth가 CPU의 95%를 넘지 않아야 함
+  if (dl_total_bw - old_bw + bw > EDF_BW_MAX) {
+    intr_set_level(old_level);
+    return false;
+  }
+  update_curr();
+  dl_total_bw = dl_total_bw - old_bw + bw;
+  timer_cancel(&curr->dl_timer);
+  curr->dl_period = period;
+  curr->dl_runtime = runtime;
+  curr->dl_deadline = deadline;
+  curr->dl_abs_deadline = timer_now_ns() + deadline;
+  curr->dl_budget = runtime;
+  curr->dl_throttled = false;
+  intr_set_level(old_level);
+
+  thread_yield();  // 더 이른 deadline이 있으면 양보
+  return true;
+}
+
 /* Returns the current thread's nice value. */
 int thread_get_nice(void) { return thread_current()->nice; }
 
@@ -516,23 +892,18 @@ void thread_update_load_avg(void) {
 int thread_get_recent_cpu(void) {
   return FP_TO_INT_ZERO(MULT_FP_INT(thread_current()->recent_cpu, 100));
 }
-void thread_update_all_recent_cpu(void) {
-  struct list_elem *e;  // thread_list 순회 시 사용하는 iterator
 
-  /* all list 순회하며 recent_cpu 갱신 */
-  for (e = list_begin(&all_list); e != list_end(&all_list); e = list_next(e)) {
-    struct thread *t = list_entry(e, struct thread, all_elem);
-    if (t != idle_thread) thread_update_recent_cpu(t);
+/* Returns COEF**N for a fixed-point COEF in [0, 1), by repeated
+   squaring. */
+static fixed_t decay_power(fixed_t coef, int64_t n) {
+  fixed_t result = INT_TO_FP(1);
+
+  while (n > 0 && result != 0) {
+    if (n & 1) result = MULT_FP(result, coef);
+    coef = MULT_FP(coef, coef);
+    n >>= 1;
   }
-}
-// 각 리스트 별로 매크로 떡칠인 라인을 넣자니 너무 지저분해서 따로 함수로 만듬
-/* recent_cpu = load_avg * 2 / (load_avg * 2 + 1) * recent_cpu  + nice */
-static void thread_update_recent_cpu(struct thread *t) {
-  t->recent_cpu =
-      ADD_FP_INT(MULT_FP(DIV_FP(MULT_FP_INT(load_avg, 2),
-                                ADD_FP_INT(MULT_FP_INT(load_avg, 2), 1)),
-                         t->recent_cpu),
-                 t->nice);
+  return result;
 }
 
 /* Idle thread.  Executes when no other thread is ready to run.
@@ -555,6 +926,10 @@ static void idle(void *idle_started_ UNUSED) {
     intr_disable();
     thread_block();
 
+    /* 당장 깨울 timer가 없다면 주기 tick을 멈추고 다음 deadline에
+       한 번만 인터럽트가 오도록 PIT를 설정한다 (-nohz). */
+    timer_idle_enter();
+
     /* Re-enable interrupts and wait for the next one.
 
        The `sti' instruction disables interrupts until the
@@ -597,19 +972,24 @@ static void init_thread(struct thread *t, const char *name, int priority) {
   t->tf.rsp = (uint64_t)t + PGSIZE - sizeof(void *);
   t->magic = THREAD_MAGIC;
 
-  t->wake_tick = 0;  // 깨워야하는 시간 초기화
-
   t->priority = priority;
   t->original_priority = priority;
-  list_init(&t->acquired_locks);
+  heap_init(&t->held_locks, donation_less, NULL);
   t->waiting_for_lock = NULL;
-  t->is_donated = 0;
 
   /* mlfqs 멤버 초기화 */
   t->nice = 0;
   t->recent_cpu = INT_TO_FP(0);
+  t->decay_epoch = decay_epoch;
 
   t->user_rsp = 0;  // vm_try_handle_fault를 위해 있음
+#ifdef USERPROG
+  t->proc = t;  // 처음엔 혼자인 프로세스의 리더
+  sema_init(&t->thread_exited, 0);
+  list_init(&t->proc_threads);
+#endif
+
+  timer_setup(&t->dl_timer, edf_replenish, t);  // EDF budget replenish
 }
 
 /* Chooses and returns the next thread to be scheduled.  Should
@@ -618,23 +998,9 @@ static void init_thread(struct thread *t, const char *name, int priority) {
    will be in the run queue.)  If the run queue is empty, return
    idle_thread. */
 static struct thread *next_thread_to_run(void) {
-  if (thread_mlfqs) {  // mlfqs 일 때
-    int max_priority;
-    if ((max_priority = max_priority_mlfqs_queue()) >=
-        0) {  // ready 다중 큐에서 존재하는 가장 높은 prioirty 반환
-      ready_threads_count--;  // ready_thread_count를 뺌
-      struct thread *selected = list_entry(
-          list_pop_front(&mlfqs_ready_queues[max_priority - PRI_MIN]),
-          struct thread, elem);
-      return selected;
-    } else  // 큐에 존재하는 쓰레드가 없을 때
-      return idle_thread;
-  } else {  // 일반적인 경우 일 때
-    if (list_empty(&ready_list))
-      return idle_thread;
-    else
-      return list_entry(list_pop_front(&ready_list), struct thread, elem);
-  }
+  struct thread *t = ready_queue_pop();
+
+  return t != NULL ? t : idle_thread;  // 큐에 존재하는 쓰레드가 없을 때
 }
 
 /* Use iretq to launch the thread */
@@ -677,62 +1043,15 @@ void do_iret(struct intr_frame *tf) {
    complete.  In practice that means that printf()s should be
    added at the end of the function. */
 static void thread_launch(struct thread *th) {
-  uint64_t tf_cur = (uint64_t)&running_thread()->tf;
-  uint64_t tf = (uint64_t)&th->tf;
   ASSERT(intr_get_level() == INTR_OFF);
 
-  /* The main switching logic.
-   * We first restore the whole execution context into the intr_frame
-   * and then switching to the next thread by calling do_iret.
-   * Note that, we SHOULD NOT use any stack from here
-   * until switching is done. */
-  __asm __volatile(
-      /* Store registers that will be used. */
-      "push %%rax\n"
-      "push %%rbx\n"
-      "push %%rcx\n"
-      /* Fetch input once */
-      "movq %0, %%rax\n"
-      "movq %1, %%rcx\n"
-      "movq %%r15, 0(%%rax)\n"
-      "movq %%r14, 8(%%rax)\n"
-      "movq %%r13, 16(%%rax)\n"
-      "movq %%r12, 24(%%rax)\n"
-      "movq %%r11, 32(%%rax)\n"
-      "movq %%r10, 40(%%rax)\n"
-      "movq %%r9, 48(%%rax)\n"
-      "movq %%r8, 56(%%rax)\n"
-      "movq %%rsi, 64(%%rax)\n"
-      "movq %%rdi, 72(%%rax)\n"
-      "movq %%rbp, 80(%%rax)\n"
-      "movq %%rdx, 88(%%rax)\n"
-      "pop %%rbx\n"  // Saved rcx
-      "movq %%rbx, 96(%%rax)\n"
-      "pop %%rbx\n"  // Saved rbx
-      "movq %%rbx, 104(%%rax)\n"
-      "pop %%rbx\n"  // Saved rax
-      "movq %%rbx, 112(%%rax)\n"
-      "addq $120, %%rax\n"
-      "movw %%es, (%%rax)\n"
-      "movw %%ds, 8(%%rax)\n"
-      "addq $32, %%rax\n"
-      "call __next\n"  // read the current rip.
-      "__next:\n"
-      "pop %%rbx\n"
-      "addq $(out_iret -  __next), %%rbx\n"
-      "movq %%rbx, 0(%%rax)\n"  // rip
-      "movw %%cs, 8(%%rax)\n"   // cs
-      "pushfq\n"
-      "popq %%rbx\n"
-      "mov %%rbx, 16(%%rax)\n"  // eflags
-      "mov %%rsp, 24(%%rax)\n"  // rsp
-      "movw %%ss, 32(%%rax)\n"
-      "mov %%rcx, %%rdi\n"
-      "call do_iret\n"
-      "out_iret:\n"
-      :
-      : "g"(tf_cur), "g"(tf)
-      : "memory");
+  /* Both sides are kernel threads here, so only the callee-saved
+   * registers and the stack pointer need to survive the switch.
+   * A thread that has never run resumes in switch_entry, which
+   * still takes the iret path through its intr_frame; returning
+   * to user mode is left to the interrupt and syscall exit
+   * paths. */
+  switch_threads(&running_thread()->stack, th->stack);
 }
 
 /* Schedules a new process. At entry, interrupts must be off.
@@ -745,7 +1064,7 @@ static void do_schedule(int status) {
   while (!list_empty(&destruction_req)) {
     struct thread *victim =
         list_entry(list_pop_front(&destruction_req), struct thread, elem);
-    palloc_free_page(victim);
+    thread_page_free(victim);
   }
   thread_current()->status = status;
   schedule();
@@ -770,6 +1089,18 @@ static void schedule(void) {
 
   /* Start new time slice. */
   thread_ticks = 0;  // 쓰레드가 yield 한 이후로 지난 시간, 0으로 세팅
+  next->exec_start = timer_now_ns();
+
+  /* 자원 사용량: 나가는 쓰레드는 커널 안에 있었으므로 stime으로 */
+  if (curr != next) {
+    curr->ru.stime_ns += next->exec_start - curr->ru_stamp;
+    if (curr->status == THREAD_BLOCKED)
+      curr->ru.nvcsw++;
+    else if (curr->status == THREAD_READY)
+      curr->ru.nivcsw++;
+    next->ru_stamp = next->exec_start;
+  }
+  next->slice_exec = 0;
 
 #ifdef USERPROG
   /* Activate the new address space. */
@@ -793,6 +1124,8 @@ static void schedule(void) {
                                     // 쓰레드에 의해서 청소 되게끔
     }
 
+    trace_switch(curr, next);
+
     /* Before switching the thread, we first save the information
      * of current running. */
     thread_launch(next);  // 쓰레드별 context switch가 일어나는 함수, 기존에
@@ -812,27 +1145,308 @@ static tid_t allocate_tid(void) {
   return tid;
 }
 
-struct list *get_ready_list(void) { return &ready_list; }
-struct list *get_sleep_list(void) { return &sleep_list; }
 
-bool thread_priority_less(const struct list_elem *a, const struct list_elem *b,
-                          void *aux) {
-  struct thread *thread_a = list_entry(a, struct thread, elem);
-  struct thread *thread_b = list_entry(b, struct thread, elem);
+/* Returns the highest priority among the threads in the run
+   queue, or -1 if the run queue is empty.  O(1): the index of the
+   most significant set bit of ready_bitmap. */
+int thread_max_ready_priority(void) {
+  if (ready_bitmap == 0) return -1;  // 아예 비어있다면
+  return PRI_MIN + 63 - __builtin_clzll(ready_bitmap);
+}
+
+/* Moves T, which must be in the run queue, to the tail of the
+   queue matching its current priority.  Used when T's priority
+   changes while it is ready (donation, MLFQS recomputation). */
+void thread_requeue(struct thread *t) {
+  ASSERT(intr_get_level() == INTR_OFF);
+  ASSERT(t->status == THREAD_READY);
+
+  ready_queue_remove(t);
+  ready_queue_push(t);
+}
+
+/* Maps or unmaps the kernel page at KVA.  Kernel mappings are
+   shared by every address space, so this takes effect
+   everywhere. */
+static void guard_page_set(void *kva, bool present) {
+  uint64_t *pte = pml4e_walk(base_pml4, (uint64_t)kva, false);
+
+  ASSERT(pte != NULL);
+  if (present)
+    *pte |= PTE_P;
+  else
+    *pte &= ~PTE_P;
+  invlpg((uint64_t)kva);
+}
+
+/* Returns a page for a new thread, from the cache if
+   possible.  Its contents are garbage, except that init_thread()
+   clears the struct thread header.  Returns NULL if memory is
+   exhausted. */
+static struct thread *thread_page_alloc(void) {
+  enum intr_level old_level = intr_disable();
+  struct thread *t = NULL;
+
+  if (!list_empty(&thread_cache)) {
+    t = list_entry(list_pop_front(&thread_cache), struct thread, elem);
+    thread_cache_cnt--;
+    thread_cache_hits++;
+  } else
+    thread_cache_misses++;
+  intr_set_level(old_level);
+  if (t != NULL) return t;
+
+  if (!thread_stack_guard) return palloc_get_page(0);
+
+  // 페이지 두 개를 받아서 아래쪽은 guard로 unmap, 위쪽이 쓰레드
+  uint8_t *pages = palloc_get_multiple(0, 2);
+  if (pages == NULL) return NULL;
+  guard_page_set(pages, false);
+  return (struct thread *)(pages + PGSIZE);
+}
 
-  return thread_a->priority > thread_b->priority;
+/* Recycles the page of dead thread T into the cache, or frees it
+   if the cache is full.  Interrupts must be off. */
+static void thread_page_free(struct thread *t) {
+  ASSERT(intr_get_level() == INTR_OFF);
+  t->magic = 0;  // 죽은 쓰레드를 가리키는 포인터가 is_thread()에 걸리도록
+  if (thread_cache_cnt < THREAD_CACHE_MAX) {
+    list_push_front(&thread_cache, &t->elem);  // 최근 것이 캐시에 따뜻함
+    thread_cache_cnt++;
+  } else
+    thread_page_release(t);
 }
 
-int max_priority_mlfqs_queue(
-    void) {  // mlfqs에서 존재하는 ready_thread 중 가장 높은 우선순위를 반환
-  for (int i = PRI_MAX; i >= PRI_MIN;
-       i--) {  // 우선순위 다중 ready 큐 순회, 우선순위 높은 순으로
-    if (!list_empty(
-            &mlfqs_ready_queues[i - PRI_MIN])) {  // 노드가 있는 큐를 찾았으면
-      return i;
+/* Returns thread page T, and its guard page, to the page
+   allocator. */
+static void thread_page_release(struct thread *t) {
+  if (!thread_stack_guard) {
+    palloc_free_page(t);
+    return;
+  }
+  uint8_t *guard = (uint8_t *)t - PGSIZE;
+  guard_page_set(guard, true);
+  palloc_free_multiple(guard, 2);
+}
+
+/* Appends T to the run queue of its priority and marks the level
+   non-empty.  Interrupts must be off. */
+static void ready_queue_push(struct thread *t) {
+  int level = sched_priority(t) - PRI_MIN;
+
+  if (t->dl_period != 0) {
+    // 실시간 쓰레드: budget이 남았으면 deadline 순 트리, 아니면 replenish 대기
+    if (t->dl_throttled)
+      list_push_back(&dl_throttled, &t->elem);
+    else {
+      rb_insert(&edf_tree, &t->dl_elem);
+      ready_threads_count++;
     }
+    return;
+  }
+  if (thread_cfs) {
+    rb_insert(&cfs_tree, &t->cfs_elem);
+    cfs_load += cfs_weight(t);
+    ready_threads_count++;
+    return;
   }
-  return -1;  // 아예 비어있다면
+  t->queued_priority = sched_priority(t);
+  list_push_back(&ready_queues[level], &t->elem);
+  ready_bitmap |= 1ULL << level;
+  ready_threads_count++;
+}
+
+/* Removes T from the run queue it was pushed on.  That queue is
+   remembered in T->queued_priority, because T's priority may
+   already have been changed by the caller. */
+static void ready_queue_remove(struct thread *t) {
+  int level = t->queued_priority - PRI_MIN;
+
+  if (t->dl_period != 0) {
+    if (t->dl_throttled) {
+      list_remove(&t->elem);
+      return;
+    }
+    rb_remove(&edf_tree, &t->dl_elem);
+  } else if (thread_cfs) {
+    rb_remove(&cfs_tree, &t->cfs_elem);
+    cfs_load -= cfs_weight(t);
+  } else {
+    list_remove(&t->elem);
+    if (list_empty(&ready_queues[level])) ready_bitmap &= ~(1ULL << level);
+  }
+  ready_threads_count--;
+}
+
+/* Removes and returns the first thread of the highest non-empty
+   run queue, or a null pointer if the run queue is empty. */
+static struct thread *ready_queue_pop(void) {
+  struct thread *t = NULL;
+
+  if (!rb_empty(&edf_tree)) {
+    // 실시간 쓰레드가 있으면 deadline이 가장 이른 쓰레드가 먼저
+    t = rb_entry(rb_min(&edf_tree), struct thread, dl_elem);
+    rb_remove(&edf_tree, &t->dl_elem);
+    ready_threads_count--;
+  } else if (thread_cfs) {
+    // vruntime이 가장 작은 쓰레드, O(1)로 캐시된 leftmost
+    if (!rb_empty(&cfs_tree)) {
+      t = rb_entry(rb_min(&cfs_tree), struct thread, cfs_elem);
+      rb_remove(&cfs_tree, &t->cfs_elem);
+      cfs_load -= cfs_weight(t);
+      ready_threads_count--;
+      cfs_update_min();
+    }
+  } else if (ready_bitmap != 0) {
+    int level = 63 - __builtin_clzll(ready_bitmap);
+    struct list *q = &ready_queues[level];
+
+    t = list_entry(list_pop_front(q), struct thread, elem);
+    if (list_empty(q)) ready_bitmap &= ~(1ULL << level);
+    ready_threads_count--;
+  }
+  return t;
+}
+
+/* Returns T's CFS weight, from its nice value. */
+static uint32_t cfs_weight(const struct thread *t) { return nice_to_weight[t->nice + 20]; }
+
+/* Orders the CFS run queue by vruntime. */
+static bool cfs_less(const struct rb_elem *a, const struct rb_elem *b, void *aux UNUSED) {
+  return rb_entry(a, struct thread, cfs_elem)->vruntime < rb_entry(b, struct thread, cfs_elem)->vruntime;
+}
+
+/* Charges the running thread for the CPU time since it was last
+   charged: to its vruntime under the CFS, weighted by its nice
+   value, and to its budget if it is a real-time thread, which is
+   throttled when the budget runs out.  Interrupts must be off. */
+static void update_curr(void) {
+  struct thread *curr = running_thread();
+  uint64_t now = timer_now_ns();
+
+  ASSERT(intr_get_level() == INTR_OFF);
+  if (curr == idle_thread) return;
+
+  uint64_t delta = now - curr->exec_start;
+  curr->exec_start = now;
+  curr->slice_exec += delta;
+  if (thread_cfs) {
+    curr->vruntime += delta * NICE_0_WEIGHT / cfs_weight(curr);
+    cfs_update_min();
+  }
+  if (curr->dl_period != 0 && !curr->dl_throttled) {
+    curr->dl_budget -= delta;
+    if (curr->dl_budget <= 0) edf_throttle(curr);
+  }
+}
+
+/* Returns true if T, which was just made ready, should preempt
+   the running thread.  Real-time threads with budget left come
+   before everything else, in deadline order; below them each
+   scheduler applies its own rule. */
+static bool preempts_curr(struct thread *t) {
+  struct thread *curr = thread_current();
+  bool t_rt = t->dl_period != 0 && !t->dl_throttled;
+  bool curr_rt = curr->dl_period != 0 && !curr->dl_throttled;
+
+  if (t->dl_throttled) return false;  // replenish 전에는 실행될 수 없음
+  if (t_rt || curr_rt) return t_rt && (!curr_rt || t->dl_abs_deadline < curr->dl_abs_deadline);
+  if (thread_cfs) return cfs_preempts_curr(t);
+  return sched_priority(t) > sched_priority(curr);
+}
+
+/* Advances min_vruntime to the least vruntime among the running
+   and ready threads.  It never moves backward, so it can serve as
+   the placement floor for waking and new threads. */
+static void cfs_update_min(void) {
+  struct thread *curr = running_thread();
+  uint64_t vruntime = UINT64_MAX;
+
+  if (curr != idle_thread && curr->status == THREAD_RUNNING) vruntime = curr->vruntime;
+  if (!rb_empty(&cfs_tree)) {
+    uint64_t left = rb_entry(rb_min(&cfs_tree), struct thread, cfs_elem)->vruntime;
+    if (left < vruntime) vruntime = left;
+  }
+  if (vruntime != UINT64_MAX && vruntime > min_vruntime) min_vruntime = vruntime;
+}
+
+/* Returns true if T, which was just made ready, should preempt
+   the running thread. */
+static bool cfs_preempts_curr(struct thread *t) {
+  struct thread *curr = thread_current();
+
+  if (curr == idle_thread) return true;
+  update_curr();
+  return t->vruntime + CFS_WAKEUP_GRAN_NS < curr->vruntime;
+}
+
+/* Orders real-time threads by absolute deadline. */
+static bool edf_less(const struct rb_elem *a_, const struct rb_elem *b_, void *aux UNUSED) {
+  const struct thread *a = rb_entry(a_, struct thread, dl_elem);
+  const struct thread *b = rb_entry(b_, struct thread, dl_elem);
+
+  return a->dl_abs_deadline < b->dl_abs_deadline;
+}
+
+/* Returns T's reserved share of a CPU, RUNTIME / PERIOD, in
+   EDF_BW_SHIFT-bit fixed point. */
+static uint64_t edf_bw(const struct thread *t) {
+  return ((uint64_t)t->dl_runtime << EDF_BW_SHIFT) / t->dl_period;
+}
+
+/* Real-time thread T is waking up.  If finishing the rest of its
+   budget by the current deadline would take more than its
+   reserved bandwidth, or the deadline has already passed, starts
+   a new period now, so that a thread that sleeps cannot bank
+   bandwidth and then crowd out the others. */
+static void edf_wakeup(struct thread *t) {
+  int64_t now = timer_now_ns();
+
+  if (t->dl_abs_deadline <= now ||
+      (__int128)t->dl_budget * t->dl_deadline > (__int128)(t->dl_abs_deadline - now) * t->dl_runtime) {
+    t->dl_abs_deadline = now + t->dl_deadline;
+    t->dl_budget = t->dl_runtime;
+  }
+}
+
+/* T has used up its budget for this period.  Takes it off the
+   CPU until the next period starts, when edf_replenish() gives it
+   a new budget. */
+static void edf_throttle(struct thread *t) {
+  int64_t next = t->dl_abs_deadline - t->dl_deadline + t->dl_period;
+  int64_t wait = next - (int64_t)timer_now_ns();
+  int64_t ticks = wait > 0 ? DIV_ROUND_UP(wait, NS_PER_TICK) : 1;
+
+  t->dl_throttled = true;
+  timer_add(&t->dl_timer, timer_ticks() + ticks);
+}
+
+/* Timer callback: real-time thread T_ starts its next period. */
+static void edf_replenish(void *t_) {
+  struct thread *t = t_;
+  enum intr_level old_level = intr_disable();
+  bool ready = t->status == THREAD_READY;
+
+  // throttled 상태로 큐에서 빼야 dl_throttled 리스트에서 빠짐
+  if (ready) ready_queue_remove(t);
+  t->dl_abs_deadline += t->dl_period;
+  if (t->dl_abs_deadline <= (int64_t)timer_now_ns()) t->dl_abs_deadline = timer_now_ns() + t->dl_deadline;
+  t->dl_budget = t->dl_runtime;
+  t->dl_throttled = false;
+  if (ready) {
+    ready_queue_push(t);
+    if (preempts_curr(t)) intr_yield_on_return();
+  }
+  intr_set_level(old_level);
+}
+
+/* Releases T's reservation, if it has one. */
+static void edf_leave(struct thread *t) {
+  if (t->dl_period == 0) return;
+  dl_total_bw -= edf_bw(t);
+  timer_cancel(&t->dl_timer);
+  t->dl_period = 0;
+  t->dl_throttled = false;
 }
 
 bool is_not_idle(struct thread *t) { return t != idle_thread; }
@@ -0,0 +1,228 @@
+#include "threads/trace.h"
+
+#include <debug.h>
+#include <inttypes.h>
+#include <round.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "devices/timer.h"
+#include "threads/interrupt.h"
+#include "threads/palloc.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "threads/vaddr.h"
+
+/* Per-CPU trace state.  HEAD counts every event ever recorded;
+   the next one goes to RING[HEAD % TRACE_RING_SIZE].  Written
+   only by the owning CPU with interrupts off. */
+struct trace_cpu {
+  uint64_t head;                             /* Events recorded so far. */
+  struct sched_hist hist;                    /* Latency and slice histograms. */
+  struct sched_event ring[TRACE_RING_SIZE];  /* Most recent events. */
+};
+
+/* Indexed by CPU id.  NULL until trace_init(); events recorded
+   before that are dropped. */
+static struct trace_cpu *trace_cpus[CPU_MAX];
+
+static const char *event_names[SCHED_EV_CNT] = {
+    "switch-out", "switch-in", "wakeup", "block", "priority", "lock-handoff",
+};
+
+static struct trace_cpu *trace_this_cpu(void);
+static void record(struct trace_cpu *, enum sched_event_type, int tid, int arg, uint64_t data, uint64_t ts);
+static void hist_add(uint64_t hist[SCHED_HIST_BUCKETS], uint64_t ns);
+static void hist_print(const char *name, const uint64_t hist[SCHED_HIST_BUCKETS]);
+
+/* Allocates trace buffers for CPUs 0 through CPU_CNT - 1.  Called
+   by thread_start(), after the page allocator is up. */
+void trace_init(int cpu_cnt) {
+  size_t pages = DIV_ROUND_UP(sizeof(struct trace_cpu), PGSIZE);
+
+  ASSERT(cpu_cnt <= CPU_MAX);
+  for (int i = 0; i < cpu_cnt; i++)
+    if (trace_cpus[i] == NULL) trace_cpus[i] = palloc_get_multiple(PAL_ASSERT | PAL_ZERO, pages);
+}
+
+/* Records that PREV stops and NEXT starts running on this CPU.
+   Called by schedule() with interrupts off, right before the
+   context switch. */
+void trace_switch(struct thread *prev, struct thread *next) {
+  struct trace_cpu *tc = trace_this_cpu();
+  uint64_t now = timer_now_ns();
+
+  if (tc != NULL) {
+    record(tc, SCHED_EV_SWITCH_OUT, prev->tid, prev->status, 0, now);
+    if (is_not_idle(prev) && prev->trace_in_ns != 0) hist_add(tc->hist.slice, now - prev->trace_in_ns);
+
+    record(tc, SCHED_EV_SWITCH_IN, next->tid, next->priority, 0, now);
+    if (next->trace_wakeup_ns != 0) hist_add(tc->hist.wakeup_latency, now - next->trace_wakeup_ns);
+  }
+  next->trace_wakeup_ns = 0;
+  next->trace_in_ns = now;
+}
+
+/* Records that T was made ready by the running thread, or by an
+   interrupt handler, and starts T's wakeup latency clock. */
+void trace_wakeup(struct thread *t) {
+  enum intr_level old_level = intr_disable();
+  struct trace_cpu *tc = trace_this_cpu();
+  uint64_t now = timer_now_ns();
+
+  if (tc != NULL) record(tc, SCHED_EV_WAKEUP, t->tid, thread_current()->tid, intr_context(), now);
+  t->trace_wakeup_ns = now;
+  intr_set_level(old_level);
+}
+
+/* Records that running thread T is about to block.  The reason
+   is taken from what T is waiting for; CALLER is the return
+   address of thread_block(), which tells the rest apart. */
+void trace_block(struct thread *t, void *caller) {
+  struct trace_cpu *tc = trace_this_cpu();
+  enum sched_block_reason reason = SCHED_BLOCK_OTHER;
+
+  ASSERT(intr_get_level() == INTR_OFF);
+  if (tc == NULL) return;
+
+  if (t->waiting_for_lock != NULL)
+    reason = SCHED_BLOCK_LOCK;
+  else if (t->waiting_for_readers != NULL)
+    reason = SCHED_BLOCK_RWLOCK;
+  else if (t->cond_waiter != NULL)
+    reason = SCHED_BLOCK_COND;
+  else if (t->wait_heap != NULL)
+    reason = SCHED_BLOCK_SEMA;
+  record(tc, SCHED_EV_BLOCK, t->tid, reason, (uint64_t)caller, timer_now_ns());
+}
+
+/* Records that a donation changed T's effective priority from
+   OLD_PRIORITY to T->priority.  Interrupts must be off. */
+void trace_priority(struct thread *t, int old_priority) {
+  struct trace_cpu *tc = trace_this_cpu();
+
+  ASSERT(intr_get_level() == INTR_OFF);
+  if (tc != NULL) record(tc, SCHED_EV_PRIORITY, t->tid, t->priority, old_priority, timer_now_ns());
+}
+
+/* Records that the running thread is releasing LOCK to
+   NEXT_HOLDER, its highest-priority waiter.  Interrupts must be
+   off. */
+void trace_lock_handoff(struct lock *lock, struct thread *next_holder) {
+  struct trace_cpu *tc = trace_this_cpu();
+
+  ASSERT(intr_get_level() == INTR_OFF);
+  if (tc != NULL)
+    record(tc, SCHED_EV_LOCK_HANDOFF, next_holder->tid, thread_current()->tid, (uint64_t)lock, timer_now_ns());
+}
+
+/* Copies up to MAX of the most recent events into EVENTS and
+   returns the number copied.  Events are grouped by CPU, oldest
+   first within each CPU; sort by timestamp to interleave them.
+   Space is shared evenly among the CPUs that have events. */
+int trace_snapshot(struct sched_event *events, int max) {
+  int cpus_left = 0;
+  int n = 0;
+
+  for (int i = 0; i < CPU_MAX; i++)
+    if (trace_cpus[i] != NULL && trace_cpus[i]->head > 0) cpus_left++;
+
+  for (int i = 0; i < CPU_MAX && n < max; i++) {
+    struct trace_cpu *tc = trace_cpus[i];
+    if (tc == NULL || tc->head == 0) continue;
+
+    /* 이 CPU에 돌아가는 몫만큼 최근 이벤트를 복사 */
+    uint64_t quota = (max - n) / cpus_left--;
+    uint64_t head = tc->head;
+    barrier();
+    uint64_t first = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+    if (head - first > quota) first = head - quota;
+    for (uint64_t seq = first; seq < head; seq++) events[n + (seq - first)] = tc->ring[seq % TRACE_RING_SIZE];
+
+    /* 복사하는 동안 덮어써졌을 수 있는 앞부분은 버린다.
+       쓰는 중인 slot은 head - TRACE_RING_SIZE 번째. */
+    barrier();
+    uint64_t now_head = tc->head;
+    uint64_t valid = now_head >= TRACE_RING_SIZE ? now_head - TRACE_RING_SIZE + 1 : 0;
+    uint64_t copied = head - first;
+    if (valid > first) {
+      uint64_t lost = valid - first < copied ? valid - first : copied;
+      memmove(&events[n], &events[n + lost], (copied - lost) * sizeof *events);
+      copied -= lost;
+    }
+    n += copied;
+  }
+  return n;
+}
+
+/* Sums the histograms of all CPUs into HIST. */
+void trace_hist(struct sched_hist *hist) {
+  memset(hist, 0, sizeof *hist);
+  for (int i = 0; i < CPU_MAX; i++) {
+    struct trace_cpu *tc = trace_cpus[i];
+    if (tc == NULL) continue;
+    for (int b = 0; b < SCHED_HIST_BUCKETS; b++) {
+      hist->wakeup_latency[b] += tc->hist.wakeup_latency[b];
+      hist->slice[b] += tc->hist.slice[b];
+    }
+  }
+}
+
+/* Prints event counts and the scheduler histograms. */
+void trace_print_stats(void) {
+  uint64_t counts[SCHED_EV_CNT] = {0};
+  uint64_t total = 0;
+  struct sched_hist hist;
+
+  for (int i = 0; i < CPU_MAX; i++) {
+    struct trace_cpu *tc = trace_cpus[i];
+    if (tc == NULL) continue;
+    uint64_t first = tc->head > TRACE_RING_SIZE ? tc->head - TRACE_RING_SIZE : 0;
+    for (uint64_t seq = first; seq < tc->head; seq++) counts[tc->ring[seq % TRACE_RING_SIZE].type]++;
+    total += tc->head;
+  }
+
+  printf("Sched trace: %" PRIu64 " events", total);
+  for (int t = 0; t < SCHED_EV_CNT; t++) printf(", %" PRIu64 " %s", counts[t], event_names[t]);
+  printf(" (last %d per CPU)\n", TRACE_RING_SIZE);
+
+  trace_hist(&hist);
+  hist_print("wakeup latency", hist.wakeup_latency);
+  hist_print("time slice", hist.slice);
+}
+
+/* Returns the running CPU's trace state, or NULL before
+   trace_init(). */
+static struct trace_cpu *trace_this_cpu(void) { return trace_cpus[thread_cpu_id()]; }
+
+/* Appends an event to TC's ring.  Interrupts must be off. */
+static void record(struct trace_cpu *tc, enum sched_event_type type, int tid, int arg, uint64_t data,
+                   uint64_t ts) {
+  struct sched_event *e = &tc->ring[tc->head % TRACE_RING_SIZE];
+
+  e->ts = ts;
+  e->data = data;
+  e->tid = tid;
+  e->arg = arg;
+  e->type = type;
+  e->cpu = thread_cpu_id();
+  barrier();  // 내용을 다 쓴 뒤에 head를 올려야 reader가 검증할 수 있다
+  tc->head++;
+}
+
+/* Counts NS in the log2 bucket it falls into. */
+static void hist_add(uint64_t hist[SCHED_HIST_BUCKETS], uint64_t ns) {
+  int b = ns == 0 ? 0 : 63 - __builtin_clzll(ns);
+  hist[b < SCHED_HIST_BUCKETS ? b : SCHED_HIST_BUCKETS - 1]++;
+}
+
+/* Prints the non-empty buckets of HIST, one per line, as the
+   lower bound of the bucket in nanoseconds. */
+static void hist_print(const char *name, const uint64_t hist[SCHED_HIST_BUCKETS]) {
+  uint64_t total = 0;
+
+  for (int b = 0; b < SCHED_HIST_BUCKETS; b++) total += hist[b];
+  printf("Sched %s: %" PRIu64 " samples\n", name, total);
+  for (int b = 0; b < SCHED_HIST_BUCKETS; b++)
+    if (hist[b] != 0) printf("  >= %'12" PRIu64 " ns: %" PRIu64 "\n", b == 0 ? 0 : (uint64_t)1 << b, hist[b]);
+}
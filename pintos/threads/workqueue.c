@@ -0,0 +1,110 @@
+#include "threads/workqueue.h"
+
+#include <debug.h>
+#include <stdio.h>
+
+#include "threads/interrupt.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+
+/* Number of worker threads.  With a single worker, queued work
+   runs one item at a time in the order it was submitted. */
+#define WORKER_CNT 1
+
+/* Bottom halves raised since the last softirq_run(). */
+static struct list softirq_list;
+
+/* Work waiting for a worker thread, and the number of items in
+   it as a semaphore the workers sleep on. */
+static struct list work_list;
+static struct semaphore work_sema;
+
+static thread_func worker;
+
+/* Initializes the bottom-half queue.  Called by intr_init(),
+   before any interrupt can raise one. */
+void softirq_init(void) { list_init(&softirq_list); }
+
+/* Initializes W to call FUNC with AUX when it runs. */
+void work_init(struct work *w, work_func *func, void *aux) {
+  ASSERT(w != NULL);
+  ASSERT(func != NULL);
+
+  w->func = func;
+  w->aux = aux;
+  w->pending = false;
+}
+
+/* Queues W to run at the end of the current external interrupt,
+   or of the next one if we are not in one.  Returns false if W was
+   already pending.  May be called from an interrupt handler. */
+bool softirq_raise(struct work *w) {
+  enum intr_level old_level = intr_disable();
+  bool queued = !w->pending;
+
+  if (queued) {
+    w->pending = true;
+    list_push_back(&softirq_list, &w->elem);
+  }
+  intr_set_level(old_level);
+  return queued;
+}
+
+/* Runs every pending bottom half, including those raised while
+   it runs.  Called by intr_handler() with interrupts off, after
+   the interrupt has been acknowledged; each bottom half runs with
+   interrupts on, so further interrupts are taken meanwhile. */
+void softirq_run(void) {
+  ASSERT(intr_get_level() == INTR_OFF);
+
+  while (!list_empty(&softirq_list)) {
+    struct work *w = list_entry(list_pop_front(&softirq_list), struct work, elem);
+
+    w->pending = false;
+    intr_enable();
+    w->func(w->aux);
+    intr_disable();
+  }
+}
+
+/* Starts the worker threads.  Must be called after
+   thread_start(). */
+void workqueue_init(void) {
+  list_init(&work_list);
+  sema_init(&work_sema, 0);
+  for (int i = 0; i < WORKER_CNT; i++) {
+    char name[16];
+
+    snprintf(name, sizeof name, "kworker/%d", i);
+    thread_create(name, PRI_DEFAULT, worker, NULL);
+  }
+}
+
+/* Queues W to run in a worker thread.  Returns false if W was
+   already pending.  May be called from an interrupt handler. */
+bool workqueue_submit(struct work *w) {
+  enum intr_level old_level = intr_disable();
+  bool queued = !w->pending;
+
+  if (queued) {
+    w->pending = true;
+    list_push_back(&work_list, &w->elem);
+    sema_up(&work_sema);
+  }
+  intr_set_level(old_level);
+  return queued;
+}
+
+/* Worker thread: runs queued work in FIFO order, forever. */
+static void worker(void *aux UNUSED) {
+  for (;;) {
+    sema_down(&work_sema);
+
+    enum intr_level old_level = intr_disable();
+    struct work *w = list_entry(list_pop_front(&work_list), struct work, elem);
+    w->pending = false;
+    intr_set_level(old_level);
+
+    w->func(w->aux);
+  }
+}
@@ -0,0 +1,104 @@
+#include "userprog/futex.h"
+#include <debug.h>
+#include <hash.h>
+#include <list.h>
+#include "threads/interrupt.h"
+#include "threads/mmu.h"
+#include "threads/synch.h"
+#include "threads/vaddr.h"
+
+/* Fast user-space mutexes.
+
+   A futex is just an aligned int in user memory.  User code does
+   the uncontended case with atomic instructions and only enters
+   the kernel to sleep on the word(futex_wait) or to wake the
+   threads sleeping on it(futex_wake).  The kernel keeps no state
+   for a futex nobody is waiting on.
+
+   Waiters are kept in a small hash of lists keyed by(process,
+   user address), so threads of different processes that happen to
+   use the same address never see each other.  Each waiter lives on
+   the waiting thread's kernel stack.  Interrupts serialize all
+   access, which also makes "check the word, then sleep" atomic
+   with respect to futex_wake(). */
+
+#define FUTEX_BUCKETS 64
+
+/* A thread sleeping in futex_wait(). */
+struct futex_waiter {
+  struct list_elem elem;   /* 버킷 리스트의 노드 */
+  struct thread *proc;     /* 대기 중인 프로세스 (리더) */
+  int *uaddr;              /* 기다리는 futex 워드 */
+  struct semaphore sema;   /* 깨울 때 up */
+};
+
+static struct list buckets[FUTEX_BUCKETS];
+
+static struct list *bucket_of(struct thread *proc, int *uaddr) {
+  uintptr_t key[2] = {(uintptr_t)proc, (uintptr_t)uaddr};
+  return &buckets[hash_bytes(key, sizeof key) % FUTEX_BUCKETS];
+}
+
+void futex_init(void) {
+  for (int i = 0; i < FUTEX_BUCKETS; i++)
+    list_init(&buckets[i]);
+}
+
+/* If the int at user address UADDR still holds VAL, sleeps until
+   a futex_wake() on the same address.  Returns 0 after being woken,
+   -1 if the word held some other value or the process is exiting
+   (the sleep is cut short by thread_interrupt()), or
+   FUTEX_NOT_PRESENT if UADDR's page is not mapped right now. */
+int futex_wait(int *uaddr, int val) {
+  struct thread *cur = thread_current();
+  struct futex_waiter w;
+  enum intr_level old_level;
+  int *kaddr;
+
+  ASSERT(!intr_context());
+
+  old_level = intr_disable();
+  kaddr = pml4_get_page(cur->pml4, uaddr);
+  if (kaddr == NULL) {
+    intr_set_level(old_level);
+    return FUTEX_NOT_PRESENT;
+  }
+  if (*kaddr != val || cur->proc->exiting) {
+    intr_set_level(old_level);
+    return -1;
+  }
+
+  w.proc = cur->proc;
+  w.uaddr = uaddr;
+  sema_init(&w.sema, 0);
+  list_push_back(bucket_of(w.proc, uaddr), &w.elem);
+  if (!sema_down_interruptible(&w.sema)) {
+    // futex_wake()가 꺼내지 않았으니 직접 뺀다
+    list_remove(&w.elem);
+    intr_set_level(old_level);
+    return -1;
+  }
+  intr_set_level(old_level);
+  return 0;
+}
+
+/* Wakes up to CNT threads of PROC waiting on UADDR, oldest first.
+   Returns the number of threads woken. */
+int futex_wake(struct thread *proc, int *uaddr, int cnt) {
+  struct list *bucket = bucket_of(proc, uaddr);
+  enum intr_level old_level = intr_disable();
+  struct list_elem *e = list_begin(bucket);
+  int woken = 0;
+
+  while (woken < cnt && e != list_end(bucket)) {
+    struct futex_waiter *w = list_entry(e, struct futex_waiter, elem);
+    e = list_next(e);
+    if (w->proc == proc && w->uaddr == uaddr) {
+      list_remove(&w->elem);
+      sema_up(&w->sema);
+      woken++;
+    }
+  }
+  intr_set_level(old_level);
+  return woken;
+}
@@ -22,6 +22,7 @@
 #include "threads/thread.h"
 #include "threads/vaddr.h"
 #include "threads/vaddr.h"  // PGSIZE
+#include "userprog/futex.h"
 #include "userprog/gdt.h"
 #include "userprog/syscall.h"
 #include "userprog/tss.h"
@@ -33,6 +34,18 @@ static void process_cleanup(void);
 static bool load(const char *file_name, struct intr_frame *if_);
 static void initd(void *f_name);
 static void __do_fork(void *);
+static void uthread_start(void *);
+static void uthread_exit(struct thread *cur);
+static void stop_threads(struct thread *proc);
+static void release_children(struct thread *proc);
+static void child_link(struct child_status *cs);
+static void child_unlink(struct child_status *cs);
+static void child_status_put(struct child_status *cs);
+static void process_rusage_self(struct thread *proc, struct rusage *ru);
+static void rusage_add(struct rusage *dst, const struct rusage *src);
+
+/* Set by the "-rusage" kernel command-line option. */
+bool process_rusage_report;
 
 static void fd_table_init(struct thread *current);
 static bool duplicate_pte(uint64_t *pte, void *va, void *aux);
@@ -49,6 +62,13 @@ struct fork_args {
   struct child_status *cs;
 };
 
+/* thread_create 시스템 콜이 새 유저 쓰레드에게 건네는 구조체 */
+struct uthread_args {
+  struct thread *proc;   /* 합류할 프로세스 (리더) */
+  struct intr_frame if_; /* 유저 모드 진입 컨텍스트 */
+  int *clear_tid;        /* 끝날 때 0을 쓰고 futex_wake할 주소 */
+};
+
 /* 제대로된 dup2 */
 struct dupmap_ent {
   struct file *parent_fp;  // 키
@@ -59,13 +79,34 @@ struct dupmap_ent {
 /* General process initializer for initd and other process. */
 /* initd 및 기타 프로세스를 위한 일반 초기화 함수. */
 static void process_init(void) {
-  struct thread *current = thread_current();
-  if (!current->proc_inited) {
-    list_init(&current->children);
-    current->proc_inited = true;
+  struct thread *proc = thread_current()->proc;
+  if (!proc->proc_inited) {
+    list_init(&proc->children);
+    proc->proc_inited = true;
   }
 }
 
+/* children은 프로세스의 모든 쓰레드가 함께 쓰므로 인터럽트를 끄고 다룬다 */
+static void child_link(struct child_status *cs) {
+  enum intr_level old_level = intr_disable();
+  list_push_back(&thread_current()->proc->children, &cs->elem);
+  intr_set_level(old_level);
+}
+
+static void child_unlink(struct child_status *cs) {
+  enum intr_level old_level = intr_disable();
+  list_remove(&cs->elem);
+  intr_set_level(old_level);
+}
+
+/* 부모와 자식이 나눠 가진 CS의 참조 하나를 놓는다 */
+static void child_status_put(struct child_status *cs) {
+  enum intr_level old_level = intr_disable();
+  bool last = --cs->ref_cnt == 0;
+  intr_set_level(old_level);
+  if (last) free(cs);
+}
+
 /* 해시 */
 static unsigned dupmap_hash(const struct hash_elem *e, void *aux) {
   const struct dupmap_ent *x = hash_entry(e, struct dupmap_ent, elem);
@@ -127,6 +168,7 @@ tid_t process_create_initd(const char *file_name) {
 
   cs->tid = TID_ERROR;
   cs->exit_code = -1;
+  memset(&cs->ru, 0, sizeof cs->ru);
   cs->exited = false;
   cs->waited = false;
   cs->ref_cnt = 2;
@@ -134,11 +176,11 @@ tid_t process_create_initd(const char *file_name) {
   sema_init(&cs->load_sema, 0);
   cs->load_done = false;
   cs->load_ok = false;
-  list_push_back(&thread_current()->children, &cs->elem);
+  child_link(cs);
 
   struct exec_info *ei = malloc(sizeof *ei);
   if (!ei) {
-    list_remove(&cs->elem);
+    child_unlink(cs);
     free(cs);
     palloc_free_page(fn_copy);
     return TID_ERROR;
@@ -150,7 +192,7 @@ tid_t process_create_initd(const char *file_name) {
   /* FILE_NAME을 실행할 새 스레드를 생성한다. */
   tid = thread_create(tname, PRI_DEFAULT, initd, ei);
   if (tid == TID_ERROR) {
-    list_remove(&cs->elem);
+    child_unlink(cs);
     free(cs);
     palloc_free_page(fn_copy);
     free(ei);
@@ -215,6 +257,7 @@ tid_t process_fork(const char *name, struct intr_frame *if_ UNUSED) {
   if (!cs) return TID_ERROR;
   cs->tid = TID_ERROR;
   cs->exit_code = -1;
+  memset(&cs->ru, 0, sizeof cs->ru);
   cs->exited = false;
   cs->waited = false;
   cs->ref_cnt = 2;  // parent + child
@@ -222,13 +265,13 @@ tid_t process_fork(const char *name, struct intr_frame *if_ UNUSED) {
   sema_init(&cs->load_sema, 0);  // fork에서는 안 쓰지만 구조체 일관성
   cs->load_done = true;          // fork 경로는 사용 안 함
   cs->load_ok = true;
-  list_push_back(&parent->children, &cs->elem);
+  child_link(cs);
 
   /* Clone current thread to new thread.*/
   /* 현재 스레드를 새 스레드로 복제. */
   struct fork_args *fa = malloc(sizeof *fa);
   if (!fa) {
-    list_remove(&cs->elem);
+    child_unlink(cs);
     free(cs);
     return TID_ERROR;
   }
@@ -238,7 +281,7 @@ tid_t process_fork(const char *name, struct intr_frame *if_ UNUSED) {
 
   tid_t tid = thread_create(name, PRI_DEFAULT, __do_fork, fa);
   if (tid == TID_ERROR) {
-    list_remove(&cs->elem);
+    child_unlink(cs);
     free(cs);
     free(fa);
     return TID_ERROR;
@@ -247,8 +290,8 @@ tid_t process_fork(const char *name, struct intr_frame *if_ UNUSED) {
 
   sema_down(&cs->load_sema);
   if (!cs->load_ok) {
-    list_remove(&cs->elem);
-    if (--cs->ref_cnt == 0) free(cs);
+    child_unlink(cs);
+    child_status_put(cs);
     return TID_ERROR;
   }
   return tid;
@@ -312,7 +355,7 @@ static bool duplicate_pte(uint64_t *pte, void *va, void *aux) {
 static void __do_fork(void *aux) {
   struct fork_args *fa = aux;
   struct intr_frame if_;
-  struct thread *parent = fa->parent;
+  struct thread *parent = fa->parent->proc;  // 워커가 fork해도 프로세스 단위로 복제
   struct child_status *cs = fa->cs;
   struct thread *current = thread_current();
   /* TODO: somehow pass the parent_if. (i.e. process_fork()'s if_) */
@@ -381,9 +424,9 @@ static void __do_fork(void *aux) {
         nf = file_duplicate(p);
         if (!nf) goto fork_rollback;
         if (!fdref_inc(nf)) {  // 자식 내 참조 1 등록
-          lock_acquire(&filesys_lock);
+          rwlock_write_acquire(&filesys_lock);
           file_close(nf);
-          lock_release(&filesys_lock);
+          rwlock_write_release(&filesys_lock);
           goto fork_rollback;
         }
         current->fd_table[i] = nf;
@@ -406,6 +449,7 @@ static void __do_fork(void *aux) {
   sema_up(&cs->load_sema);
 
   if_.R.rax = 0;
+  thread_ru_leave_kernel();
 
   /* Finally, switch to the newly created process. */
   /* 마지막으로 새로 생성한 프로세스로 전환한다. */
@@ -441,6 +485,16 @@ int process_exec(void *f_name) {
   char *cmdline = f_name;
   struct thread *t = thread_current();
 
+  /* 워커 쓰레드는 주소 공간을 혼자 갈아엎을 수 없고,
+     이미 끝나는 중인 프로세스는 exec하지 않는다 */
+  if (t->proc != t || t->exiting) {
+    palloc_free_page(cmdline);
+    return -1;
+  }
+  /* 리더는 다른 쓰레드를 모두 끝낸 뒤 혼자가 되어 exec한다 */
+  if (t->nthreads > 0) stop_threads(t);
+  t->exiting = false;
+
   /* We cannot use the intr_frame in the thread structure.
    * This is because when current thread rescheduled,
    * it stores the execution information to the member. */
@@ -449,10 +503,10 @@ int process_exec(void *f_name) {
 
   /* 기존 exec_file이 있다면 정리 (exec 체인 대비) */
   if (t->exec_file) {
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     file_allow_write(t->exec_file);
     file_close(t->exec_file);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
     t->exec_file = NULL;
   }
 
@@ -571,6 +625,7 @@ int process_exec(void *f_name) {
 
   /* Start switched process. */
   /* 전환된 프로세스를 시작한다. */
+  thread_ru_leave_kernel();
   do_iret(&_if);
   NOT_REACHED();
 }
@@ -607,28 +662,40 @@ int process_wait(tid_t child_tid UNUSED) {
   /* XXX: 힌트) process_wait(initd)를 호출하면 pintos가 종료된다.
    * XXX:       process_wait를 구현하기 전에는 이곳에 무한 루프를 넣는 것을
    * 권장한다. */
-  struct thread *cur = thread_current();
+  /* 자식은 프로세스 단위: 어느 쓰레드든 기다릴 수 있지만 한 번만 */
+  struct thread *proc = thread_current()->proc;
+  struct child_status *cs = NULL;
   struct list_elem *e;
+  enum intr_level old_level = intr_disable();
 
-  for (e = list_begin(&cur->children); e != list_end(&cur->children);
+  for (e = list_begin(&proc->children); e != list_end(&proc->children);
        e = list_next(e)) {
-    struct child_status *cs = list_entry(e, struct child_status, elem);
-    if (cs->tid == child_tid) {
-      if (cs->waited) return -1;  // 이걸로 중복 wait 막음
-      cs->waited = true;
-
-      if (!cs->exited) sema_down(&cs->sema);
-
-      int ex_code = cs->exit_code;
+    struct child_status *c = list_entry(e, struct child_status, elem);
+    if (c->tid == child_tid) {
+      cs = c;
+      break;
+    }
+  }
+  if (cs == NULL || cs->waited) {  // 내 자식 아님, 존재안함, 또는 중복 wait
+    intr_set_level(old_level);
+    return -1;
+  }
+  cs->waited = true;
 
-      list_remove(&cs->elem);
+  /* 프로세스가 끝나는 중이라 인터럽트되면 기다리지 않은 것으로 되돌린다 */
+  if (!sema_down_interruptible(&cs->sema)) {
+    cs->waited = false;
+    intr_set_level(old_level);
+    return -1;
+  }
 
-      if (--cs->ref_cnt == 0) free(cs);
+  int ex_code = cs->exit_code;
+  rusage_add(&proc->ru_children, &cs->ru);
+  list_remove(&cs->elem);
+  intr_set_level(old_level);
 
-      return ex_code;
-    }
-  }
-  return -1;  // 내 자식 아님 또는 존재안함
+  child_status_put(cs);
+  return ex_code;
 }
 
 /* Exit the process. This function is called by thread_exit (). */
@@ -644,6 +711,13 @@ void process_exit(void) {
    * TODO: 프로세스 자원 해제를 여기에서 구현하는 것을 권장한다. */
   struct thread *cur = thread_current();
 
+  if (cur->proc != cur) {
+    uthread_exit(cur);
+    return;
+  }
+  /* 주소 공간과 fd를 치우기 전에 같은 프로세스의 쓰레드를 모두 끝낸다 */
+  if (cur->nthreads > 0) stop_threads(cur);
+
   if (cur->fd_table) {
     for (int i = 0; i < cur->fd_cap; i++) {
       struct file *p = cur->fd_table ? cur->fd_table[i] : NULL;
@@ -654,10 +728,10 @@ void process_exit(void) {
   }
 
   if (cur->exec_file) {
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     file_allow_write(cur->exec_file);
     file_close(cur->exec_file);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
     cur->exec_file = NULL;
   }
 
@@ -673,29 +747,246 @@ void process_exit(void) {
 
   /* 유저 프로세스 에서만 */
   if (cur->proc_inited) {
+    struct rusage ru;
+    process_rusage_self(cur, &ru);
+
     /* 스펙 요구 종료 메시지 */
     printf("%s: exit(%d)\n", cur->name, cur->exit_status);
+    if (process_rusage_report)
+      printf("%s: rusage utime=%" PRIu64 "us stime=%" PRIu64 "us nvcsw=%" PRIu64
+             " nivcsw=%" PRIu64 " minflt=%" PRIu64 " majflt=%" PRIu64
+             " nswapin=%" PRIu64 " inblock=%" PRIu64 " oublock=%" PRIu64 "\n",
+             cur->name, ru.utime_ns / 1000, ru.stime_ns / 1000, ru.nvcsw,
+             ru.nivcsw, ru.minflt, ru.majflt, ru.nswapin, ru.inblock,
+             ru.oublock);
 
     if (cur->my_status) {
+      cur->my_status->ru = ru;
+      rusage_add(&cur->my_status->ru, &cur->ru_children);
       cur->my_status->exit_code = cur->exit_status;
       cur->my_status->exited = true;
       sema_up(&cur->my_status->sema);
 
-      if (--cur->my_status->ref_cnt == 0) free(cur->my_status);
+      child_status_put(cur->my_status);
       cur->my_status = NULL;
     }
 
-    /* 부모가 wait 안하고 죽는 불상사 방지용 */
-    /* 자식들의 부모 소유 해제 */
-    while (!list_empty(&cur->children)) {
-      struct list_elem *e = list_pop_front(&cur->children);
-      struct child_status *cs = list_entry(e, struct child_status, elem);
-      if (--cs->ref_cnt == 0) free(cs);
-    }
+    release_children(cur);
   }
   process_cleanup();
 }
 
+/* 부모가 wait 안하고 죽는 불상사 방지용 */
+/* 자식들의 부모 소유 해제. 다른 쓰레드가 모두 끝난 뒤 리더가 부른다 */
+static void release_children(struct thread *proc) {
+  while (!list_empty(&proc->children)) {
+    struct list_elem *e = list_pop_front(&proc->children);
+    child_status_put(list_entry(e, struct child_status, elem));
+  }
+}
+
+/* Starts a new thread in the current process that enters user mode
+   at ENTRY with ARG as its first argument and STACK as its stack
+   pointer (as if ENTRY had just been called).  When the thread
+   exits, 0 is stored at CLEAR_TID, if non-null, and one thread
+   waiting on it with futex_wait() is woken.  Returns the new
+   thread's tid, or TID_ERROR. */
+tid_t process_thread_create(void *entry, void *arg, void *stack,
+                            int *clear_tid) {
+  struct thread *cur = thread_current();
+  struct thread *proc = cur->proc;
+  enum intr_level old_level;
+
+  if (proc->exiting) return TID_ERROR;
+
+  struct uthread_args *ua = malloc(sizeof *ua);
+  if (ua == NULL) return TID_ERROR;
+  memset(&ua->if_, 0, sizeof ua->if_);
+  ua->if_.rip = (uintptr_t)entry;
+  ua->if_.R.rdi = (uint64_t)arg;
+  ua->if_.rsp = (uintptr_t)stack;
+  ua->if_.ds = ua->if_.es = ua->if_.ss = SEL_UDSEG;
+  ua->if_.cs = SEL_UCSEG;
+  ua->if_.eflags = FLAG_IF | FLAG_MBS;
+  ua->proc = proc;
+  ua->clear_tid = clear_tid;
+
+  /* 새 쓰레드가 돌기 전에 세어 둬야 리더가 기다릴 수 있다 */
+  old_level = intr_disable();
+  proc->nthreads++;
+  intr_set_level(old_level);
+
+  tid_t tid = thread_create(cur->name, PRI_DEFAULT, uthread_start, ua);
+  if (tid == TID_ERROR) {
+    free(ua);
+    old_level = intr_disable();
+    proc->nthreads--;
+    sema_up(&proc->thread_exited);
+    intr_set_level(old_level);
+  }
+  return tid;
+}
+
+/* A thread function that joins the process in AUX and jumps to
+   user mode. */
+static void uthread_start(void *aux) {
+  struct uthread_args *ua = aux;
+  struct thread *cur = thread_current();
+  struct intr_frame if_;
+
+  memcpy(&if_, &ua->if_, sizeof if_);
+  cur->proc = ua->proc;
+  cur->clear_tid = ua->clear_tid;
+  free(ua);
+
+  /* 주소 공간은 리더 것을 그대로 쓴다. fd_table과 spt는 항상
+     proc을 통해 접근하므로 복사하지 않는다. */
+  cur->pml4 = cur->proc->pml4;
+  cur->user_rsp = (void *)if_.rsp;
+  process_activate(cur);
+
+  enum intr_level old_level = intr_disable();
+  list_push_back(&cur->proc->proc_threads, &cur->proc_elem);
+  intr_set_level(old_level);
+
+  process_check_exit();
+  thread_ru_leave_kernel();
+  do_iret(&if_);
+  NOT_REACHED();
+}
+
+/* Exits the current thread if another thread of its process has
+   started to terminate the process.  Called on every return to
+   user mode. */
+void process_check_exit(void) {
+  if (thread_current()->proc->exiting) {
+    intr_enable();
+    thread_exit();
+  }
+}
+
+/* process_exit() for a thread that is not the process's leader:
+   releases only what belongs to the thread itself. */
+static void uthread_exit(struct thread *cur) {
+  struct thread *proc = cur->proc;
+  enum intr_level old_level;
+
+  /* pthread_join이 기다리는 tid 워드를 지우고 깨운다 */
+  /* 커널은 CR0.WP 없이 돌아 읽기 전용 매핑에도 써지므로, 사용자 주소에
+     직접 쓰지 말고 copy-on-write·제로 프레임 공유를 끊어 주는
+     user_copy_out()을 거친다 */
+  int *ctid = cur->clear_tid;
+  if (ctid != NULL && pg_ofs(ctid) % sizeof *ctid == 0) {
+    const int zero = 0;
+    if (user_copy_out(ctid, &zero, sizeof zero)) futex_wake(proc, ctid, 1);
+  }
+
+  /* pml4는 리더 소유. 다시 활성화되지 않게 먼저 끊는다 */
+  cur->pml4 = NULL;
+  pml4_activate(NULL);
+
+  old_level = intr_disable();
+  struct rusage ru;
+  thread_get_rusage(cur, &ru);
+  rusage_add(&proc->ru_exited, &ru);
+  list_remove(&cur->proc_elem);
+  proc->nthreads--;
+  sema_up(&proc->thread_exited);
+  intr_set_level(old_level);
+}
+
+/* Stores the resource usage of the current process in RU: all of
+   its threads if WHO is RUSAGE_SELF, the calling thread alone if
+   RUSAGE_THREAD, or its waited-for children if RUSAGE_CHILDREN.
+   Returns false if WHO is none of these. */
+bool process_get_rusage(int who, struct rusage *ru) {
+  struct thread *cur = thread_current();
+  enum intr_level old_level;
+
+  switch (who) {
+    case RUSAGE_SELF:
+      process_rusage_self(cur->proc, ru);
+      return true;
+    case RUSAGE_THREAD:
+      thread_get_rusage(cur, ru);
+      return true;
+    case RUSAGE_CHILDREN:
+      old_level = intr_disable();
+      *ru = cur->proc->ru_children;
+      intr_set_level(old_level);
+      return true;
+    default:
+      return false;
+  }
+}
+
+/* Sums the usage of every thread of PROC, live or exited. */
+static void process_rusage_self(struct thread *proc, struct rusage *ru) {
+  enum intr_level old_level = intr_disable();
+  struct rusage t_ru;
+  struct list_elem *e;
+
+  thread_get_rusage(proc, ru);
+  rusage_add(ru, &proc->ru_exited);
+  for (e = list_begin(&proc->proc_threads); e != list_end(&proc->proc_threads);
+       e = list_next(e)) {
+    thread_get_rusage(list_entry(e, struct thread, proc_elem), &t_ru);
+    rusage_add(ru, &t_ru);
+  }
+  intr_set_level(old_level);
+}
+
+static void rusage_add(struct rusage *dst, const struct rusage *src) {
+  dst->utime_ns += src->utime_ns;
+  dst->stime_ns += src->stime_ns;
+  dst->nvcsw += src->nvcsw;
+  dst->nivcsw += src->nivcsw;
+  dst->minflt += src->minflt;
+  dst->majflt += src->majflt;
+  dst->nswapin += src->nswapin;
+  dst->inblock += src->inblock;
+  dst->oublock += src->oublock;
+}
+
+/* Marks PROC as exiting and waits until all of its other threads
+   have exited.  PROC must be the running thread. */
+static void stop_threads(struct thread *proc) {
+  enum intr_level old_level = intr_disable();
+
+  ASSERT(proc == thread_current());
+
+  proc->exiting = true;
+  /* futex, wait, 콘솔 입력 등에서 자는 쓰레드를 깨운다. 유저 모드에서
+     도는 쓰레드는 다음 인터럽트에서, 커널에 있는 쓰레드는 시스템 콜을
+     마치고 process_check_exit()로 빠져 나온다. */
+  process_interrupt_threads(proc);
+  while (proc->nthreads > 0) sema_down(&proc->thread_exited);
+  intr_set_level(old_level);
+}
+
+/* Interrupts every thread of PROC other than the running one out
+   of any interruptible sleep (thread_interrupt()), so that it
+   notices PROC is exiting.  Threads created later see
+   PROC->exiting on their own. */
+void process_interrupt_threads(struct thread *proc) {
+  struct thread *cur = thread_current();
+  enum intr_level old_level = intr_disable();
+  struct list_elem *e;
+
+  if (proc != cur) thread_interrupt(proc);
+  /* thread_interrupt()가 양보하면 목록이 바뀔 수 있어 매번 처음부터 훑는다 */
+  e = list_begin(&proc->proc_threads);
+  while (e != list_end(&proc->proc_threads)) {
+    struct thread *t = list_entry(e, struct thread, proc_elem);
+    if (t != cur && !t->interrupted) {
+      thread_interrupt(t);
+      e = list_begin(&proc->proc_threads);
+    } else
+      e = list_next(e);
+  }
+  intr_set_level(old_level);
+}
+
 /* Free the current process's resources. */
 /* 현재 프로세스의 자원을 해제한다. */
 static void process_cleanup(void) {
@@ -845,9 +1136,9 @@ static bool load(const char *file_name, struct intr_frame *if_) {
 
   /* Open executable file. */
   /* 실행 파일을 연다. */
-  lock_acquire(&filesys_lock);
+  rwlock_write_acquire(&filesys_lock);
   file = filesys_open(file_name);
-  lock_release(&filesys_lock);
+  rwlock_write_release(&filesys_lock);
   if (file == NULL) {
     printf("load: %s: open failed\n", file_name);
     goto done;
@@ -855,9 +1146,9 @@ static bool load(const char *file_name, struct intr_frame *if_) {
 
   /* Read and verify executable header. */
   /* 실행 파일 헤더를 읽고 검증한다. */
-  lock_acquire(&filesys_lock);
+  rwlock_read_acquire(&filesys_lock);
   off_t hdr_read = file_read(file, &ehdr, sizeof ehdr);
-  lock_release(&filesys_lock);
+  rwlock_read_release(&filesys_lock);
   if (hdr_read != (off_t)sizeof ehdr || memcmp(ehdr.e_ident, "\177ELF\2\1\1", 7) ||
       ehdr.e_type != 2 ||
       ehdr.e_machine != 0x3E  // amd64
@@ -874,17 +1165,17 @@ static bool load(const char *file_name, struct intr_frame *if_) {
   for (i = 0; i < ehdr.e_phnum; i++) {
     struct Phdr phdr;
 
-    lock_acquire(&filesys_lock);
+    rwlock_read_acquire(&filesys_lock);
     off_t flen = file_length(file);
-    lock_release(&filesys_lock);
+    rwlock_read_release(&filesys_lock);
     if (file_ofs < 0 || file_ofs > flen) goto done;
-    lock_acquire(&filesys_lock);
+    rwlock_read_acquire(&filesys_lock);
     file_seek(file, file_ofs);
-    lock_release(&filesys_lock);
+    rwlock_read_release(&filesys_lock);
 
-    lock_acquire(&filesys_lock);
+    rwlock_read_acquire(&filesys_lock);
     off_t phr_read = file_read(file, &phdr, sizeof phdr);
-    lock_release(&filesys_lock);
+    rwlock_read_release(&filesys_lock);
     if (phr_read != (off_t)sizeof phdr) goto done;
     file_ofs += sizeof phdr;
     switch (phdr.p_type) {
@@ -945,9 +1236,9 @@ static bool load(const char *file_name, struct intr_frame *if_) {
   /* TODO: 여기에 코드를 작성한다.
    * TODO: 인자 전달을 구현하라 (project2/argument_passing.html 참고). */
   t->exec_file = file;
-  lock_acquire(&filesys_lock);
+  rwlock_write_acquire(&filesys_lock);
   file_deny_write(file);
-  lock_release(&filesys_lock);
+  rwlock_write_release(&filesys_lock);
   file = NULL;
 
   success = true;
@@ -956,9 +1247,9 @@ done:
   /* We arrive here whether the load is successful or not. */
   /* 성공 여부와 관계없이 이 지점으로 온다. */
   if (file) {
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     file_close(file);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
   }
   return success;
 }
@@ -974,9 +1265,9 @@ static bool validate_segment(const struct Phdr *phdr, struct file *file) {
 
   /* p_offset must point within FILE. */
   /* p_offset은 FILE의 범위 안을 가리켜야 한다. */
-  lock_acquire(&filesys_lock);
+  rwlock_read_acquire(&filesys_lock);
   off_t flen = file_length(file);
-  lock_release(&filesys_lock);
+  rwlock_read_release(&filesys_lock);
   if (phdr->p_offset > (uint64_t)flen) return false;
 
   /* p_memsz must be at least as big as p_filesz. */
@@ -1061,9 +1352,9 @@ static bool load_segment(struct file *file, off_t ofs, uint8_t *upage,
   ASSERT(pg_ofs(upage) == 0);
   ASSERT(ofs % PGSIZE == 0);
 
-  lock_acquire(&filesys_lock);
+  rwlock_read_acquire(&filesys_lock);
   file_seek(file, ofs);
-  lock_release(&filesys_lock);
+  rwlock_read_release(&filesys_lock);
   while (read_bytes > 0 || zero_bytes > 0) {
     /* Do calculate how to fill this page.
      * We will read PAGE_READ_BYTES bytes from FILE
@@ -1082,9 +1373,9 @@ static bool load_segment(struct file *file, off_t ofs, uint8_t *upage,
     /* Load this page. */
     /* 이 페이지에 내용을 적재한다. */
     if (page_read_bytes > 0) {
-      lock_acquire(&filesys_lock);
+      rwlock_read_acquire(&filesys_lock);
       off_t got = file_read(file, kpage, page_read_bytes);
-      lock_release(&filesys_lock);
+      rwlock_read_release(&filesys_lock);
       if (got != (off_t)page_read_bytes) {
         palloc_free_page(kpage);
         return false;
@@ -1168,9 +1459,9 @@ static bool lazy_load_segment(struct page *page, void *aux_) {
 
   /* 파일에서 필요한 만큼 읽기 */
   if (aux->read_bytes > 0) {
-    lock_acquire(&filesys_lock);
+    rwlock_read_acquire(&filesys_lock);
     int n = file_read_at(aux->file, kva, aux->read_bytes, aux->ofs);
-    lock_release(&filesys_lock);
+    rwlock_read_release(&filesys_lock);
     if (n != (int)aux->read_bytes) {
       free(aux);
       return false;
@@ -1241,6 +1532,15 @@ static bool load_segment(struct file *file, off_t ofs, uint8_t *upage,
     size_t page_read_bytes = read_bytes < PGSIZE ? read_bytes : PGSIZE;
     size_t page_zero_bytes = PGSIZE - page_read_bytes;
 
+    /* 파일에서 읽을 것이 없는 페이지(BSS)는 0으로 채운 익명 페이지로
+     * 등록해, 읽기만 하면 제로 프레임을 공유하게 한다. */
+    if (page_read_bytes == 0) {
+      if (!vm_alloc_page(VM_ANON, upage, writable)) return false;
+      zero_bytes -= page_zero_bytes;
+      upage += PGSIZE;
+      continue;
+    }
+
     /* TODO: Set up aux to pass information to the lazy_load_segment. */
     /* TODO: lazy_load_segment에 정보를 전달하기 위한 aux를 설정한다. */
     struct load_aux *aux = malloc(sizeof *aux);
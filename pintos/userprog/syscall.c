@@ -4,7 +4,7 @@
 #include <string.h>
 #include <syscall-nr.h>
 
-#include "devices/input.h"  // input_getc()
+#include "devices/input.h"  // input_getc_interruptible()
 #include "filesys/directory.h"
 #include "filesys/file.h"
 #include "filesys/filesys.h"
@@ -13,17 +13,21 @@
 #include "list.h"
 #include "threads/flags.h"
 #include "threads/init.h"
+#include "threads/lockstat.h"
 #include "threads/loader.h"
+#include "threads/malloc.h"
 #include "threads/mmu.h"     // pml4_get_page()
 #include "threads/palloc.h"  // palloc_get_page, palloc_free_page
 #include "threads/synch.h"
 #include "threads/thread.h"
+#include "threads/trace.h"
 #include "threads/vaddr.h"  // is_user_vaddr()
+#include "userprog/futex.h"
 #include "userprog/gdt.h"
 #include "userprog/process.h"
 #include "vm/vm.h"
 
-struct lock filesys_lock;
+struct rwlock filesys_lock;
 
 void syscall_entry(void);
 void syscall_handler(struct intr_frame *);
@@ -77,12 +81,25 @@ static void *system_mmap(void *addr, size_t length, int writable, int fd,
 
 static void system_munmap(void *addr);
 
+static int system_sched_trace(struct sched_event *events, int max,
+                              struct sched_hist *hist);
+static int system_lockstat(struct lock_stat *stats, int max);
+
+static tid_t system_thread_create(void *entry, void *arg, void *stack,
+                                  int *tidp);
+static void system_thread_exit(void) NO_RETURN;
+static int system_futex_wait(int *uaddr, int val);
+static int system_futex_wake(int *uaddr, int cnt);
+
+static int system_getrusage(int who, struct rusage *usage);
+
 /* 시스템콜 헬퍼 */
 static struct file *fd_get(int fd);
 static void assert_user_range(const void *uaddr, size_t size);
 static bool copy_in_string(char *kdst, const char *usrc, size_t max_len);
 static void copy_in(void *kdst, const void *usrc, size_t n);
 static void copy_out(void *udst, const void *ksrc, size_t n);
+static void check_user_buffer(const void *ubuf, size_t n, bool write);
 static int fd_alloc(struct file *f);  // 빈 슬롯 찾아 file* 넣고 fd 반환
 
 static unsigned file_ref_hash(const struct hash_elem *e, void *aux);
@@ -141,16 +158,20 @@ void syscall_init(void) {
   write_msr(MSR_SYSCALL_MASK,
             FLAG_IF | FLAG_TF | FLAG_DF | FLAG_IOPL | FLAG_AC | FLAG_NT);
 
-  lock_init(&filesys_lock);
+  rwlock_init(&filesys_lock);
+  rwlock_set_name(&filesys_lock, "filesys_lock");
   // list_init(&file_ref_list);
   lock_init(&file_ref_lock);
+  lock_set_name(&file_ref_lock, "file_ref_lock");
   hash_init(&file_ref_ht, file_ref_hash, file_ref_less, NULL);
+  futex_init();
 }
 
 /* The main system call interface */
 /* 주요 시스템 콜 인터페이스 */
 /* 개쩌는 가시성 (아님) */
 void syscall_handler(struct intr_frame *f) {
+  thread_ru_enter_kernel();
   thread_current()->user_rsp = f->rsp;  // vm_try_handle_fault를 위해 있음
   switch (SC_NO(f)) {
     case SYS_HALT:
@@ -218,10 +239,42 @@ void syscall_handler(struct intr_frame *f) {
       system_munmap((void *)ARG0(f));
       break;
 
+    case SYS_SCHED_TRACE:
+      RET(f, system_sched_trace((struct sched_event *)ARG0(f), (int)ARG1(f),
+                                (struct sched_hist *)ARG2(f)));
+      break;
+
+    case SYS_LOCKSTAT:
+      RET(f, system_lockstat((struct lock_stat *)ARG0(f), (int)ARG1(f)));
+      break;
+
+    /* 유저 쓰레드 */
+    case SYS_THREAD_CREATE:
+      RET(f, system_thread_create((void *)ARG0(f), (void *)ARG1(f),
+                                  (void *)ARG2(f), (int *)ARG3(f)));
+      break;
+    case SYS_THREAD_EXIT:
+      system_thread_exit();
+      __builtin_unreachable();
+    case SYS_FUTEX_WAIT:
+      RET(f, system_futex_wait((int *)ARG0(f), (int)ARG1(f)));
+      break;
+    case SYS_FUTEX_WAKE:
+      RET(f, system_futex_wake((int *)ARG0(f), (int)ARG1(f)));
+      break;
+
+    case SYS_GETRUSAGE:
+      RET(f, system_getrusage((int)ARG0(f), (struct rusage *)ARG1(f)));
+      break;
+
     default:
       system_exit(-1);
       __builtin_unreachable();
   }
+
+  /* 다른 쓰레드가 프로세스를 끝내는 중이면 유저 모드로 돌아가지 않는다 */
+  process_check_exit();
+  thread_ru_leave_kernel();
 }
 
 static void system_halt(void) {
@@ -229,9 +282,18 @@ static void system_halt(void) {
   __builtin_unreachable();
 }
 
+/* Terminates the whole process with STATUS.  If several threads of
+   the process exit at once, the first status wins; the others
+   threads leave through process_check_exit(). */
 void system_exit(int status) {
-  struct thread *cur = thread_current();
-  cur->exit_status = status;
+  struct thread *proc = thread_current()->proc;
+  enum intr_level old_level = intr_disable();
+  if (!proc->exiting) {
+    proc->exit_status = status;
+    proc->exiting = true;
+    process_interrupt_threads(proc);
+  }
+  intr_set_level(old_level);
   thread_exit();
   __builtin_unreachable();
 }
@@ -241,9 +303,9 @@ static unsigned system_tell(int fd) {
   if (f == NULL) return -1;
   if (f == STDOUT_FD || f == STDIN_FD) return -1;
 
-  lock_acquire(&filesys_lock);
+  rwlock_read_acquire(&filesys_lock);
   off_t pose = file_tell(f);
-  lock_release(&filesys_lock);
+  rwlock_read_release(&filesys_lock);
   return pose;
 }
 
@@ -279,9 +341,9 @@ static bool system_create(const char *file, unsigned initial_size) {
     return false;
   }
 
-  lock_acquire(&filesys_lock);
+  rwlock_write_acquire(&filesys_lock);
   bool crt = filesys_create(kname, initial_size);
-  lock_release(&filesys_lock);
+  rwlock_write_release(&filesys_lock);
   return crt;
 }
 
@@ -289,9 +351,9 @@ static bool system_remove(const char *file) {
   char kname[NAME_MAX + 1];
   if (!copy_in_string(kname, file, sizeof kname)) return false;
 
-  lock_acquire(&filesys_lock);
+  rwlock_write_acquire(&filesys_lock);
   bool rem = filesys_remove(kname);
-  lock_release(&filesys_lock);
+  rwlock_write_release(&filesys_lock);
   return rem;
 }
 
@@ -299,31 +361,31 @@ static int system_open(const char *file) {
   char kname[NAME_MAX + 1];
   if (!copy_in_string(kname, file, sizeof kname)) return -1;
 
-  lock_acquire(&filesys_lock);
+  rwlock_write_acquire(&filesys_lock);
   struct file *f = filesys_open(kname);
-  lock_release(&filesys_lock);
+  rwlock_write_release(&filesys_lock);
   if (f == NULL) return -1;
 
   int fd = fd_alloc(f);
   if (fd < 0) {
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     file_close(f);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
     return -1;
   }
 
   if (!fdref_inc(f)) {  // 실패 시
-    thread_current()->fd_table[fd] = NULL;
-    lock_acquire(&filesys_lock);
+    thread_current()->proc->fd_table[fd] = NULL;
+    rwlock_write_acquire(&filesys_lock);
     file_close(f);  // 직접 닫기
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
     return -1;
   }
   return fd;
 }
 
 static void system_close(int fd) {
-  struct thread *t = thread_current();
+  struct thread *t = thread_current()->proc;
 
   if (fd < 0 || fd >= t->fd_cap) return;  // 범위 밖
   struct file *f = t->fd_table[fd];
@@ -339,9 +401,9 @@ static int system_filesize(int fd) {
   if (f == STDOUT_FD || f == STDIN_FD) return -1;
   if (f == NULL) return -1;
 
-  lock_acquire(&filesys_lock);
+  rwlock_read_acquire(&filesys_lock);
   off_t len = file_length(f);
-  lock_release(&filesys_lock);
+  rwlock_read_release(&filesys_lock);
   return (int)len;
 }
 
@@ -353,7 +415,9 @@ static int system_read(int fd, void *buffer, unsigned size) {
 
   if (f == STDIN_FD) {  // 키보드
     for (unsigned i = 0; i < size; i++) {
-      uint8_t key = (uint8_t)input_getc();
+      uint8_t key;
+      // 프로세스가 끝나는 중이라 인터럽트되면 읽은 만큼만 돌려준다
+      if (!input_getc_interruptible(&key)) return i > 0 ? (int)i : -1;
       copy_out((uint8_t *)buffer + i, &key, 1);
     }
     return (int)size;
@@ -370,9 +434,9 @@ static int system_read(int fd, void *buffer, unsigned size) {
     size_t chunk = size - total;
     if (chunk > PGSIZE) chunk = PGSIZE;
 
-    lock_acquire(&filesys_lock);
+    rwlock_read_acquire(&filesys_lock);
     off_t n = file_read(f, read_page, (off_t)chunk);
-    lock_release(&filesys_lock);
+    rwlock_read_release(&filesys_lock);
 
     if (n <= 0) break;
 
@@ -423,9 +487,9 @@ static long system_write(int fd, const void *buf, unsigned size) {
 
     copy_in(kpage, (const uint8_t *)buf + total, chunk);
 
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     off_t n = file_write(f, kpage, chunk);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
 
     if (n <= 0) break;
     total += (long)n;
@@ -440,13 +504,14 @@ static void system_seek(int fd, unsigned position) {
   if (f == NULL) return;
   if (f == STDOUT_FD || f == STDIN_FD) return;
 
-  lock_acquire(&filesys_lock);
+  /* 위치는 file의 pos_lock이 지키므로 공유 잠금으로 충분하다 */
+  rwlock_read_acquire(&filesys_lock);
   file_seek(f, position);
-  lock_release(&filesys_lock);
+  rwlock_read_release(&filesys_lock);
 }
 
 static int system_dup2(int oldfd, int newfd) {
-  struct thread *t = thread_current();
+  struct thread *t = thread_current()->proc;
 
   if (oldfd < 0 || oldfd >= t->fd_cap) return -1;
   if (oldfd >= t->fd_cap || newfd >= t->fd_cap) return -1;
@@ -490,7 +555,7 @@ void *system_mmap(void *addr, size_t length, int writable, int fd,
 
 // fd 뽑아보기
 static struct file *fd_get(int fd) {
-  struct thread *t = thread_current();
+  struct thread *t = thread_current()->proc;
   if (fd < 0 || fd >= t->fd_cap) return NULL;
   return t->fd_table[fd];
 }
@@ -511,30 +576,45 @@ static void assert_user_range(const void *uaddr, size_t size) {
   }
 }
 
-/* 페이지 가능 여부 체크 후 그래도 안되면 걍 exit */
-static inline void *ensure_user_kva(const void *u, bool write) {
+/* U가 든 페이지를 올리고(WRITE면 copy-on-write나 제로 프레임 공유도 끊고)
+   그 페이지의 kva를 돌려준다. 잘못된 주소면 NULL.
+   PINNED가 NULL이 아니면 kva로 읽고 쓰는 동안 쫓겨나지 않도록 프레임을
+   고정해 *PINNED에 담는다(제로 프레임이면 NULL). 다 쓰면
+   vm_unpin_frame()으로 풀어야 한다. */
+static void *user_kva(const void *u, bool write, struct frame **pinned) {
   struct thread *t = thread_current();
-  if (!is_user_vaddr(u)) system_exit(-1);
+  if (pinned != NULL) *pinned = NULL;
+  if (!is_user_vaddr(u)) return NULL;
 
   void *pg = pg_round_down(u);
 
   /* 1) 이미 매핑돼 있으면 그대로 사용 */
   void *kva = pml4_get_page(t->pml4, pg);
   if (kva != NULL) {
-    struct page *p = spt_find_page(&t->spt, pg);
-    if (p == NULL) system_exit(-1);
-    if (write && !p->writable) system_exit(-1);
+    struct page *p = spt_find_page(&t->proc->spt, pg);
+    if (p == NULL) return NULL;
+    if (write && !p->writable) return NULL;
+    /* 커널은 kva로 쓰므로 copy-on-write 공유나 제로 프레임 매핑을 직접
+       끊어야 한다 */
+    if (write && (p->cow || p->zero)) {
+      if (!(p->zero ? vm_zero_break(p) : vm_cow_break(p))) return NULL;
+      return user_kva(u, write, pinned);
+    }
+    if (pinned != NULL && !p->zero) {
+      /* 그 사이 쫓겨났으면 다시 올린다 */
+      *pinned = vm_pin_page(p);
+      if (*pinned == NULL) return user_kva(u, write, pinned);
+      kva = (*pinned)->kva;
+    }
     return kva;
   }
 
   /* 2) SPT에 등록된 페이지면 claim해서 매핑 */
-  struct page *p = spt_find_page(&t->spt, pg);
+  struct page *p = spt_find_page(&t->proc->spt, pg);
   if (p != NULL) {
-    if (write && !p->writable) system_exit(-1);
-    if (!vm_claim_page(pg)) system_exit(-1);
-    kva = pml4_get_page(t->pml4, pg);
-    if (kva == NULL) system_exit(-1);
-    return kva;
+    if (write && !p->writable) return NULL;
+    if (!vm_claim_page(pg)) return NULL;
+    return user_kva(u, write, pinned);
   }
 
   /* 3) USER_STACK 기준 1MiB 이내면 새로 만들고 claim (스택 성장) */
@@ -549,16 +629,20 @@ static inline void *ensure_user_kva(const void *u, bool write) {
   bool near_rsp = (ua + 8) >= (rsp - 64) && ua < (uintptr_t)USER_STACK;
 
   if (write && in_stack_window && near_rsp) {
-    if (!vm_alloc_page(VM_ANON | VM_MARKER_0, pg, true)) system_exit(-1);
-    if (!vm_claim_page(pg)) system_exit(-1);
-    kva = pml4_get_page(t->pml4, pg);
-    if (kva == NULL) system_exit(-1);
-    return kva;
+    if (!vm_alloc_page(VM_ANON | VM_MARKER_0, pg, true)) return NULL;
+    if (!vm_claim_page(pg)) return NULL;
+    return user_kva(u, write, pinned);
   }
 
   /* 그것도 아니면 잘못된 접근 */
-  system_exit(-1);
-  __builtin_unreachable();
+  return NULL;
+}
+
+/* 페이지 가능 여부 체크 후 그래도 안되면 걍 exit */
+static inline void *ensure_user_kva(const void *u, bool write) {
+  void *kva = user_kva(u, write, NULL);
+  if (kva == NULL) system_exit(-1);
+  return kva;
 }
 
 static bool copy_in_string(char *kdst, const char *usrc, size_t max_len) {
@@ -567,12 +651,21 @@ static bool copy_in_string(char *kdst, const char *usrc, size_t max_len) {
   size_t i = 0;
   while (i < max_len) {
     const uint8_t *u = (const uint8_t *)usrc + i;
-
-    uint8_t *kbase = ensure_user_kva(u, false);
-
-    char c = *(((char *)kbase) + pg_ofs(u));  // base + ofs 로 1바이트 읽기
-    kdst[i++] = c;
-    if (c == '\0') return true;  // 정상 종료: 제한 내에서 NUL 발견
+    struct frame *pinned;
+
+    const char *kbase = user_kva(u, false, &pinned);
+    if (kbase == NULL) system_exit(-1);
+
+    // 같은 페이지 안에서는 고정한 kva로 이어 읽는다
+    size_t ofs = pg_ofs(u);
+    bool found = false;
+    while (i < max_len && ofs < PGSIZE && !found) {
+      char c = kbase[ofs++];  // base + ofs 로 1바이트 읽기
+      kdst[i++] = c;
+      found = c == '\0';  // 정상 종료: 제한 내에서 NUL 발견
+    }
+    if (pinned != NULL) vm_unpin_frame(pinned);
+    if (found) return true;
   }
 
   kdst[max_len - 1] = '\0';  // 끝문자열 null 처리 (최대 길이 벗어나서 절삭)
@@ -584,12 +677,15 @@ static void copy_in(void *kdst, const void *usrc, size_t n) {
   const uint8_t *u = (const uint8_t *)usrc;
 
   while (n > 0) {
-    uint8_t *kbase = ensure_user_kva(u, false);
+    struct frame *pinned;
+    uint8_t *kbase = user_kva(u, false, &pinned);
+    if (kbase == NULL) system_exit(-1);
 
     size_t chunk = PGSIZE - pg_ofs(u);
     if (chunk > n) chunk = n;
 
     memcpy(kd, kbase + pg_ofs(u), chunk);
+    if (pinned != NULL) vm_unpin_frame(pinned);
     kd += chunk;
     u += chunk;
     n -= chunk;
@@ -597,24 +693,46 @@ static void copy_in(void *kdst, const void *usrc, size_t n) {
 }
 
 static void copy_out(void *udst, const void *ksrc, size_t n) {
+  if (!user_copy_out(udst, ksrc, n)) system_exit(-1);
+}
+
+/* 커널 자원(malloc 등)을 잡기 전에 유저 버퍼 N바이트를 미리 확인한다.
+   잡은 뒤 copy_in/copy_out에서 exit 당하면 그 자원이 새기 때문 */
+static void check_user_buffer(const void *ubuf, size_t n, bool write) {
+  if (n == 0) return;
+  const uint8_t *end = (const uint8_t *)ubuf + n - 1;
+  for (const uint8_t *p = pg_round_down(ubuf); p <= end; p += PGSIZE)
+    ensure_user_kva(p, write);
+}
+
+/* Copies N bytes from KSRC to user address UDST of the current
+   process, first giving any copy-on-write or zero-frame page there
+   a private frame.  Returns false if UDST is not writable user
+   memory.  Unlike copy_out(), does not kill the process, so it can
+   be used on the way out. */
+bool user_copy_out(void *udst, const void *ksrc, size_t n) {
   uint8_t *u = (uint8_t *)udst;
   const uint8_t *k = (const uint8_t *)ksrc;
 
   while (n > 0) {
-    uint8_t *kbase = ensure_user_kva(u, true);
+    struct frame *pinned;
+    uint8_t *kbase = user_kva(u, true, &pinned);
+    if (kbase == NULL) return false;
 
     size_t chunk = PGSIZE - pg_ofs(u);
     if (chunk > n) chunk = n;
 
     memcpy(kbase + pg_ofs(u), k, chunk);
+    if (pinned != NULL) vm_unpin_frame(pinned);
     u += chunk;
     k += chunk;
     n -= chunk;
   }
+  return true;
 }
 
 static bool fd_ensure_table(void) {
-  struct thread *t = thread_current();
+  struct thread *t = thread_current()->proc;
   if (t->fd_table && t->fd_cap > 0) return true;
 
   int cap = FD_GROW_STEP;
@@ -632,7 +750,7 @@ static bool fd_ensure_table(void) {
 }
 
 static int fd_alloc(struct file *f) {
-  struct thread *t = thread_current();
+  struct thread *t = thread_current()->proc;
   if (!fd_ensure_table()) return -1;
 
   for (int i = FIRST_FD; i < t->fd_cap; i++) {
@@ -689,9 +807,9 @@ void fdref_dec(struct file *fp) {
     hash_delete(&file_ref_ht, &r->elem);
     lock_release(&file_ref_lock);
     // 마지막 참조 해제 시 실제 close
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     file_close(fp);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
     free(r);
     return;
   }
@@ -721,7 +839,7 @@ static void system_munmap(void *addr) {
 
   if (addr == NULL || is_kernel_vaddr(addr)) return;
 
-  struct page *page = spt_find_page(&thread_current()->spt, addr);
+  struct page *page = spt_find_page(&thread_current()->proc->spt, addr);
   if (page == NULL) return;
   // 페이지가 없으면 매핑되지 않은 주소이기 때문에 종료
 
@@ -729,4 +847,102 @@ static void system_munmap(void *addr) {
   // 다른 타입이면 종료
 
   do_munmap(addr);
+}
+
+/* Copies up to MAX of the most recent scheduler trace events to
+   EVENTS and, if HIST is not NULL, the scheduler histograms to
+   HIST.  Returns the number of events copied, or -1. */
+static int system_sched_trace(struct sched_event *events, int max,
+                              struct sched_hist *hist) {
+  if (max < 0) return -1;
+  if (max > TRACE_RING_SIZE) max = TRACE_RING_SIZE;
+
+  if (hist != NULL) {
+    struct sched_hist h;
+    trace_hist(&h);
+    copy_out(hist, &h, sizeof h);
+  }
+  if (max == 0) return 0;
+
+  size_t size = max * sizeof *events;
+  check_user_buffer(events, size, true);
+
+  struct sched_event *buf = malloc(size);
+  if (buf == NULL) return -1;
+
+  // 한 번에 찍어야 ring이 덮어써지는 것을 최소화할 수 있다
+  enum intr_level old_level = intr_disable();
+  int n = trace_snapshot(buf, max);
+  intr_set_level(old_level);
+
+  copy_out(events, buf, n * sizeof *buf);
+  free(buf);
+  return n;
+}
+
+/* Copies up to MAX lock statistics records to STATS.  Returns the
+   number copied, 0 if lock statistics are off, or -1. */
+static int system_lockstat(struct lock_stat *stats, int max) {
+  if (max < 0) return -1;
+  if (max > LOCKSTAT_MAX) max = LOCKSTAT_MAX;
+  if (max == 0) return 0;
+
+  size_t size = max * sizeof *stats;
+  check_user_buffer(stats, size, true);
+
+  struct lock_stat *buf = malloc(size);
+  if (buf == NULL) return -1;
+  int n = lockstat_snapshot(buf, max);
+  copy_out(stats, buf, n * sizeof *buf);
+  free(buf);
+  return n;
+}
+
+/* Starts a thread in the current process at ENTRY(ARG) on STACK.
+   When the thread exits, 0 is stored at TIDP, if non-null, and a
+   waiter on it is woken, so TIDP works as a join word. */
+static tid_t system_thread_create(void *entry, void *arg, void *stack,
+                                  int *tidp) {
+  if (entry == NULL || !is_user_vaddr(entry)) return TID_ERROR;
+  if (stack == NULL || !is_user_vaddr(stack)) return TID_ERROR;
+  if (tidp != NULL) {
+    if ((uintptr_t)tidp % sizeof *tidp != 0) return TID_ERROR;
+    ensure_user_kva(tidp, true);
+  }
+  return process_thread_create(entry, arg, stack, tidp);
+}
+
+/* Exits the calling thread only.  For the process's first thread
+   this is the same as exit(0). */
+static void system_thread_exit(void) {
+  struct thread *cur = thread_current();
+  if (cur->proc == cur) system_exit(0);
+  thread_exit();
+}
+
+static int system_futex_wait(int *uaddr, int val) {
+  if ((uintptr_t)uaddr % sizeof *uaddr != 0) return -1;
+
+  // 워드가 쫓겨나 있으면 다시 올리고 재시도
+  for (;;) {
+    ensure_user_kva(uaddr, false);
+    int r = futex_wait(uaddr, val);
+    if (r != FUTEX_NOT_PRESENT) return r;
+  }
+}
+
+static int system_futex_wake(int *uaddr, int cnt) {
+  if (!is_user_vaddr(uaddr) || (uintptr_t)uaddr % sizeof *uaddr != 0)
+    return -1;
+  if (cnt <= 0) return 0;
+  return futex_wake(thread_current()->proc, uaddr, cnt);
+}
+
+/* Stores the resource usage selected by WHO (enum rusage_who) in
+   USAGE.  Returns 0, or -1 if WHO is invalid. */
+static int system_getrusage(int who, struct rusage *usage) {
+  struct rusage ru;
+  if (!process_get_rusage(who, &ru)) return -1;
+  copy_out(usage, &ru, sizeof ru);
+  return 0;
 }
\ No newline at end of file
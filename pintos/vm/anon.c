@@ -1,11 +1,10 @@
 /* anon.c: Implementation of page for non-disk image (a.k.a. anonymous page). */
 #include "vm/anon.h"
 
-#include "devices/disk.h"
-#include "lib/kernel/bitmap.h"
 #include "threads/mmu.h"
-#include "threads/synch.h"
+#include "threads/thread.h"
 #include "threads/vaddr.h"
+#include "vm/swap.h"
 #include "vm/vm.h"
 
 /* DO NOT MODIFY BELOW LINE */
@@ -13,14 +12,6 @@ static bool anon_swap_in(struct page *page, void *kva);
 static bool anon_swap_out(struct page *page);
 static void anon_destroy(struct page *page);
 
-// 전역 변수
-static struct bitmap *swap_table;
-static struct disk *swap_disk;
-
-// 비트 마스킹용 락
-struct lock swap_lock;
-static const size_t SECTORS_PER_SLOT = PGSIZE / DISK_SECTOR_SIZE;
-
 /* DO NOT MODIFY this struct */
 static const struct page_operations anon_ops = {
     .swap_in = anon_swap_in,
@@ -31,24 +22,8 @@ static const struct page_operations anon_ops = {
 
 /* 익명 페이지를 위한 데이터를 초기화 합니다. */
 void vm_anon_init(void) {
-  /* swap_disk를 설정하세요 */
-  swap_disk = disk_get(1, 1);
-  if (swap_disk == NULL) {
-    return;
-  }
-
-  disk_sector_t swap_dsize = disk_size(swap_disk);
-  size_t swap_slot_size = PGSIZE / DISK_SECTOR_SIZE;
-  size_t slot_count = swap_dsize / swap_slot_size;
-
-  swap_table = bitmap_create(slot_count);
-  if (swap_table == NULL) {
-    return;
-  }
-
-  // void라 리턴없고 비트맵 설정 후 락 초기화
-  bitmap_set_all(swap_table, false);
-  lock_init(&swap_lock);
+  /* 스왑 디스크와 슬롯 관리는 vm/swap.c가 맡는다 */
+  swap_init();
 }
 
 /* anon_page를 초기화 합니다. */
@@ -65,16 +40,11 @@ static bool anon_swap_in(struct page *page, void *kva) {
   size_t slot = anon_page->slot_idx;
 
   if (slot == SIZE_MAX) return false;
-  if (swap_disk == NULL) return false;
 
-  lock_acquire(&swap_lock);
-  for (size_t i = 0; i < SECTORS_PER_SLOT; i++) {
-    disk_read(swap_disk, slot * SECTORS_PER_SLOT + i,
-              (uint8_t *)kva + DISK_SECTOR_SIZE * i);
-  }
-  bitmap_reset(swap_table, slot);
-  anon_page->slot_idx = SIZE_MAX;
-  lock_release(&swap_lock);
+  /* 슬롯 참조를 쥐고 있으니 읽는 동안 swap_lock은 필요 없다 */
+  swap_read(slot, kva);
+  swap_release(&anon_page->slot_idx);
+  thread_current()->ru.nswapin++;
   return true;
 }
 
@@ -83,24 +53,11 @@ static bool anon_swap_out(struct page *page) {
   struct anon_page *anon = &page->anon;
   struct frame *frame = page->frame;
   if (frame == NULL) return false;
-  if (swap_disk == NULL) return false;
 
-  lock_acquire(&swap_lock);
-  size_t slot = anon->slot_idx;
-  if (slot == SIZE_MAX) {
-    slot = bitmap_scan_and_flip(swap_table, 0, 1, false);
-    if (slot == BITMAP_ERROR) {
-      lock_release(&swap_lock);
-      return false;
-    }
-    anon->slot_idx = slot;
-  }
-
-  for (size_t i = 0; i < SECTORS_PER_SLOT; i++) {
-    disk_write(swap_disk, slot * SECTORS_PER_SLOT + i,
-               (uint8_t *)frame->kva + DISK_SECTOR_SIZE * i);
-  }
-  lock_release(&swap_lock);
+  size_t slot = swap_alloc();
+  if (slot == SIZE_MAX) return false;
+  swap_write(slot, frame->kva);
+  anon->slot_idx = slot;
   return true;
 }
 
@@ -108,23 +65,30 @@ static bool anon_swap_out(struct page *page) {
 static void anon_destroy(struct page *page) {
   struct anon_page *ap = &page->anon;
 
+  /* 0) 쫓겨나는 중이면 끝날 때까지 기다린다: 슬롯과 프레임이 그 뒤에 정해진다 */
+  vm_wait_evicted(page);
+
   /* 1) 스왑 슬롯 해제: 프레임 유무와 무관하게, 슬롯이 있으면 해제 */
-  if (ap->slot_idx != SIZE_MAX) {
-    lock_acquire(&swap_lock);
-    bitmap_reset(swap_table, ap->slot_idx);
-    lock_release(&swap_lock);
-    ap->slot_idx = SIZE_MAX;
-  }
+  swap_release(&ap->slot_idx);
 
-  /* 2) 프레임 반납: 매핑 해제 → 연결 해제 → 프레임 free */
+  /* 2) 프레임 반납: 매핑 해제 → 연결 해제 → 프레임 free.
+     다른 프로세스와 공유 중인 프레임이면 빠지기만 한다 */
   struct frame *frame = page->frame;
   if (frame != NULL) {
     struct thread *owner = page->owner;
     if (owner && owner->pml4) {
       pml4_clear_page(owner->pml4, page->va);
     }
+    if (vm_frame_unshare(page)) return;
     frame->page = NULL;
     page->frame = NULL;
     vm_free_frame(frame);
   }
 }
+
+/* Makes anonymous page DST refer to the swap slot holding SRC's
+   contents, so that each of them reads it back on its next
+   fault.  Does nothing if SRC is not in swap. */
+void anon_share_slot(struct page *src, struct page *dst) {
+  swap_share(&src->anon.slot_idx, &dst->anon.slot_idx);
+}
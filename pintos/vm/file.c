@@ -15,7 +15,7 @@ static bool file_backed_swap_out(struct page *page);
 static void file_backed_destroy(struct page *page);
 static bool lazy_load_mmap(struct page *page, void *aux_);
 
-extern struct lock filesys_lock;
+extern struct rwlock filesys_lock;
 
 /* DO NOT MODIFY this struct */
 static const struct page_operations file_ops = {
@@ -49,10 +49,10 @@ static bool file_backed_swap_in(struct page *page, void *kva) {
 
   if (file_page->read_bytes > 0) {
     if (file_page->file == NULL) return false;
-    lock_acquire(&filesys_lock);
+    rwlock_read_acquire(&filesys_lock);
     off_t n = file_read_at(file_page->file, kva, file_page->read_bytes,
                            file_page->offset);
-    lock_release(&filesys_lock);
+    rwlock_read_release(&filesys_lock);
     if (n != (off_t)file_page->read_bytes) {
       return false;
     }
@@ -74,10 +74,10 @@ static bool file_backed_swap_out(struct page *page) {
 
   bool dirty = pml4_is_dirty(owner->pml4, page->va);
   if (dirty && file_page->file) {
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     off_t written = file_write_at(file_page->file, frame->kva,
                                   file_page->read_bytes, file_page->offset);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
     if (written != (off_t)file_page->read_bytes) return false;
     pml4_set_dirty(owner->pml4, page->va, false);
   }
@@ -88,6 +88,8 @@ static bool file_backed_swap_out(struct page *page) {
 
 /* Destory the file backed page. PAGE will be freed by the caller. */
 static void file_backed_destroy(struct page *page) {
+  // reclaim 쓰레드가 쫓아내는 중이면 끝나고 나서 정리한다
+  vm_wait_evicted(page);
   struct file_page *file_page = &page->file;
   struct frame *frame = page->frame;
   struct thread *owner = page->owner;
@@ -96,10 +98,10 @@ static void file_backed_destroy(struct page *page) {
   if (frame != NULL) {
     if (file_page->file != NULL && pml4 != NULL &&
         pml4_is_dirty(pml4, page->va) && file_page->read_bytes > 0) {
-      lock_acquire(&filesys_lock);
+      rwlock_write_acquire(&filesys_lock);
       off_t written = file_write_at(file_page->file, frame->kva,
                                     file_page->read_bytes, file_page->offset);
-      lock_release(&filesys_lock);
+      rwlock_write_release(&filesys_lock);
       if (written == (off_t)file_page->read_bytes) {
         pml4_set_dirty(pml4, page->va, false);
       }
@@ -116,9 +118,9 @@ static void file_backed_destroy(struct page *page) {
   }
 
   if (file_page->owns_file && file_page->file != NULL) {
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     file_close(file_page->file);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
   }
   file_page->file = NULL;
   file_page->owns_file = false;
@@ -142,9 +144,9 @@ void *do_mmap(void *addr, size_t length, int writable, struct file *file,
   if (file == NULL) return NULL;
 
   // 파일 객체의 byte 길이
-  lock_acquire(&filesys_lock);
+  rwlock_read_acquire(&filesys_lock);
   off_t file_len = file_length(file);
-  lock_release(&filesys_lock);
+  rwlock_read_release(&filesys_lock);
   if (file_len == 0) {
     return NULL;
   }
@@ -155,7 +157,7 @@ void *do_mmap(void *addr, size_t length, int writable, struct file *file,
   // [추가] 겹침 사전 검사: 대상 범위에 뭐라도 있으면 실패
   for (size_t i = 0; i < page_count; i++) {
     if (!is_user_vaddr(upage)) return NULL;
-    if (spt_find_page(&cur->spt, upage) != NULL) return NULL;
+    if (spt_find_page(&cur->proc->spt, upage) != NULL) return NULL;
     upage += PGSIZE;
   }
   upage = addr;
@@ -179,9 +181,9 @@ void *do_mmap(void *addr, size_t length, int writable, struct file *file,
     size_t file_read_byte = file_left < step ? file_left : step;
     size_t file_zero_byte = PGSIZE - file_read_byte;
 
-    lock_acquire(&filesys_lock);
+    rwlock_write_acquire(&filesys_lock);
     aux->file = file_reopen(file);
-    lock_release(&filesys_lock);
+    rwlock_write_release(&filesys_lock);
     if (aux->file == NULL) {
       free(aux);
       do_munmap(upage);
@@ -195,9 +197,9 @@ void *do_mmap(void *addr, size_t length, int writable, struct file *file,
     // 페이지 할당
     if (!vm_alloc_page_with_initializer(VM_FILE, upage, writable,
                                         lazy_load_mmap, aux)) {
-      lock_acquire(&filesys_lock);
+      rwlock_write_acquire(&filesys_lock);
       file_close(aux->file);
-      lock_release(&filesys_lock);
+      rwlock_write_release(&filesys_lock);
       free(aux);
       do_munmap(upage);
       return NULL;
@@ -227,10 +229,10 @@ static bool lazy_load_mmap(struct page *page, void *aux_) {
   /* 파일에서 필요한 만큼 읽기 */
   if (file_page->read_bytes > 0) {
     off_t n;
-    lock_acquire(&filesys_lock);
+    rwlock_read_acquire(&filesys_lock);
     n = file_read_at(file_page->file, kva, file_page->read_bytes,
                      file_page->offset);
-    lock_release(&filesys_lock);
+    rwlock_read_release(&filesys_lock);
     if (n != (off_t)file_page->read_bytes) {
       return false;
     }
@@ -248,14 +250,14 @@ static bool lazy_load_mmap(struct page *page, void *aux_) {
 void do_munmap(void *addr) {
   while (1) {
     struct thread *cur = thread_current();
-    struct page *page = spt_find_page(&cur->spt, addr);
+    struct page *page = spt_find_page(&cur->proc->spt, addr);
 
     if (page == NULL) return;
 
     // struct load_aux *aux = (struct load_aux *)page->uninit.aux;
     // page->file.aux = aux;
 
-    hash_delete(&cur->spt.h, &page->spt_elem);
+    hash_delete(&cur->proc->spt.h, &page->spt_elem);
     // file_backed_destroy(page);
     vm_dealloc_page(page);
 
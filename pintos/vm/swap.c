@@ -0,0 +1,166 @@
+/* swap.c: Swap slot allocation and page-sized swap disk I/O. */
+
+#include "vm/swap.h"
+
+#include <bitmap.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "devices/disk.h"
+#include "threads/malloc.h"
+#include "threads/synch.h"
+#include "threads/vaddr.h"
+
+#define SECTORS_PER_SLOT (PGSIZE / DISK_SECTOR_SIZE)
+
+/* Slots handed out together, so that pages evicted one after
+   another end up next to each other on disk. */
+#define SWAP_CLUSTER 16
+
+static struct disk *swap_disk;
+static size_t slot_cnt;
+
+/* Protects everything below.  Held only to update slot
+   bookkeeping, never during a disk transfer. */
+static struct lock swap_lock;
+
+static struct bitmap *used_map; /* Slots that hold a page. */
+
+/* Number of pages referring to each slot.  More than one page
+   refers to a slot when a frame shared copy-on-write by forked
+   processes was swapped out. */
+static uint16_t *slot_refs;
+
+/* Current cluster: slots [cluster_next, cluster_end) are free and
+   reserved for the next swap_alloc() calls. */
+static size_t cluster_next;
+static size_t cluster_end;
+
+/* Statistics. */
+static long long swap_out_cnt;  /* Pages written. */
+static long long swap_in_cnt;   /* Pages read. */
+static long long cluster_cnt;   /* Clusters started. */
+
+static void slot_put(size_t slot);
+static bool cluster_refill(void);
+
+/* Finds the swap disk and sets up the slot table.  Without a
+   swap disk, swap_alloc() always fails. */
+void swap_init(void) {
+  lock_init(&swap_lock);
+  lock_set_name(&swap_lock, "swap_lock");
+
+  swap_disk = disk_get(1, 1);
+  if (swap_disk == NULL) return;
+
+  slot_cnt = disk_size(swap_disk) / SECTORS_PER_SLOT;
+  used_map = bitmap_create(slot_cnt);
+  slot_refs = calloc(slot_cnt, sizeof *slot_refs);
+  if (used_map == NULL || slot_refs == NULL) PANIC("swap slot table");
+  cluster_next = cluster_end = 0;
+}
+
+/* Allocates a swap slot with one reference and returns its index,
+   or SIZE_MAX if swap is full or missing. */
+size_t swap_alloc(void) {
+  size_t slot = SIZE_MAX;
+
+  if (used_map == NULL) return SIZE_MAX;
+  lock_acquire(&swap_lock);
+  if (cluster_next < cluster_end || cluster_refill()) {
+    slot = cluster_next++;
+    ASSERT(!bitmap_test(used_map, slot));
+    bitmap_mark(used_map, slot);
+    slot_refs[slot] = 1;
+  }
+  lock_release(&swap_lock);
+  return slot;
+}
+
+/* Starts a new cluster after the current one, wrapping around to
+   the start of the disk.  When no run of SWAP_CLUSTER free slots
+   is left, settles for a single free slot.  Returns false if swap
+   is full.  swap_lock must be held. */
+static bool cluster_refill(void) {
+  size_t start = bitmap_scan(used_map, cluster_end, SWAP_CLUSTER, false);
+  if (start == BITMAP_ERROR)
+    start = bitmap_scan(used_map, 0, SWAP_CLUSTER, false);
+  if (start != BITMAP_ERROR) {
+    cluster_next = start;
+    cluster_end = start + SWAP_CLUSTER;
+    cluster_cnt++;
+    return true;
+  }
+
+  start = bitmap_scan(used_map, 0, 1, false);
+  if (start == BITMAP_ERROR) return false;
+  cluster_next = start;
+  cluster_end = start + 1;
+  return true;
+}
+
+/* Drops the reference held through *SLOTP, if any, and sets
+   *SLOTP to SIZE_MAX.  The slot is freed with its last reference. */
+void swap_release(size_t *slotp) {
+  lock_acquire(&swap_lock);
+  if (*slotp != SIZE_MAX) {
+    slot_put(*slotp);
+    *slotp = SIZE_MAX;
+  }
+  lock_release(&swap_lock);
+}
+
+/* If *SRCP names a slot, takes another reference to it for *DSTP
+   and returns true.  Reading *SRCP under swap_lock keeps the slot
+   from being freed by a concurrent swap_release(SRCP). */
+bool swap_share(const size_t *srcp, size_t *dstp) {
+  bool shared = false;
+
+  lock_acquire(&swap_lock);
+  size_t slot = *srcp;
+  if (slot != SIZE_MAX) {
+    ASSERT(slot_refs[slot] > 0 && slot_refs[slot] < UINT16_MAX);
+    slot_refs[slot]++;
+    *dstp = slot;
+    shared = true;
+  }
+  lock_release(&swap_lock);
+  return shared;
+}
+
+/* Drops a reference to SLOT.  swap_lock must be held. */
+static void slot_put(size_t slot) {
+  ASSERT(slot < slot_cnt);
+  ASSERT(slot_refs[slot] > 0);
+  if (--slot_refs[slot] == 0) bitmap_reset(used_map, slot);
+}
+
+/* Reads the page in SLOT into KVA with a single multi-sector
+   command.  The caller's reference keeps SLOT alive, so no lock
+   is needed. */
+void swap_read(size_t slot, void *kva) {
+  ASSERT(slot < slot_cnt);
+  disk_read_sectors(swap_disk, slot * SECTORS_PER_SLOT, kva,
+                    SECTORS_PER_SLOT);
+  swap_in_cnt++;
+}
+
+/* Writes the page at KVA to SLOT, which the caller has just
+   allocated, with a single multi-sector command. */
+void swap_write(size_t slot, const void *kva) {
+  ASSERT(slot < slot_cnt);
+  disk_write_sectors(swap_disk, slot * SECTORS_PER_SLOT, kva,
+                     SECTORS_PER_SLOT);
+  swap_out_cnt++;
+}
+
+/* Prints swap statistics. */
+void swap_print_stats(void) {
+  if (used_map == NULL) return;
+  lock_acquire(&swap_lock);
+  size_t in_use = bitmap_count(used_map, 0, slot_cnt, true);
+  lock_release(&swap_lock);
+  printf("Swap: %lld pages out, %lld pages in, %lld clusters, "
+         "%zu of %zu slots in use\n",
+         swap_out_cnt, swap_in_cnt, cluster_cnt, in_use, slot_cnt);
+}
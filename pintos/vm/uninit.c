@@ -10,7 +10,10 @@
 
 #include "vm/uninit.h"
 
+#include <string.h>
+
 #include "threads/malloc.h"
+#include "threads/mmu.h"
 #include "vm/vm.h"
 
 static bool uninit_initialize(struct page *page, void *kva);
@@ -59,6 +62,9 @@ static bool uninit_initialize(struct page *page, void *kva) {
    * 두 단계가 모두 성공해야 true를 반환
    */
 
+  /* 초기화 함수가 없는 익명 페이지는 0으로 채워진 페이지다 */
+  if (init == NULL && VM_TYPE(uninit->type) == VM_ANON) memset(kva, 0, PGSIZE);
+
   /* TODO: You may need to fix this function. */
   return uninit->page_initializer(page, uninit->type, kva) &&
          (init ? init(page, aux) : true);
@@ -75,6 +81,11 @@ static bool uninit_initialize(struct page *page, void *kva) {
  * PAGE 자체는 호출자가 해제합니다. */
 static void uninit_destroy(struct page *page) {
   struct uninit_page *uninit UNUSED = &page->uninit;
+
+  /* 제로 프레임 매핑이 남아 있으면 pml4_destroy()가 그것을 해제하므로
+     지워 둔다 */
+  if (page->zero && page->owner && page->owner->pml4)
+    pml4_clear_page(page->owner->pml4, page->va);
   if (uninit->aux) {
     free(uninit->aux);
     uninit->aux = NULL;
@@ -2,21 +2,67 @@
 
 #include "vm/vm.h"
 
+#include <stdio.h>
 #include <string.h>
 
 #include "threads/malloc.h"
 #include "threads/mmu.h"
 #include "userprog/process.h"
 #include "vm/inspect.h"
+#include "vm/swap.h"
 
 #define STACK_LIMIT (1 << 20)
 
-extern struct lock filesys_lock;
+/* How far past an unreferenced dirty frame the clock hand keeps
+   looking for a clean one. */
+#define CLOCK_CLEAN_WINDOW 16
+
+/* Frames the reclaim thread evicts per trip through frame_lock. */
+#define RECLAIM_BATCH 8
+
+extern struct rwlock filesys_lock;
 
 static struct list frame_table;
 
 static struct lock frame_lock;
 
+/* Clock hand: the next frame_table entry vm_get_victim() looks
+   at, or NULL for the head of the list.  Protected by
+   frame_lock. */
+static struct list_elem *clock_hand;
+
+/* Background reclaim.  Once fewer than reclaim_low user frames are
+   free, vm_get_frame() wakes the reclaim thread, which evicts
+   frames in batches until reclaim_high are free again.  The frames
+   below reclaim_low are a reserve that faults allocate from
+   without waiting for eviction I/O; only when it runs dry does a
+   fault evict for itself.  Counts are protected by frame_lock. */
+static size_t user_frame_cnt;   /* Size of the user pool. */
+static size_t used_frame_cnt;   /* User pool frames handed out. */
+static size_t reclaim_low, reclaim_high;
+static struct semaphore reclaim_sema;
+static bool reclaim_pending;    /* reclaim_sema has been upped. */
+static void reclaim_thread(void *aux);
+
+/* Shared zero frame.  Untouched anonymous memory that is read
+   before it is written is mapped read-only to this one page of
+   zeros from the kernel pool; see vm_map_zero(). */
+static void *zero_kva;
+
+/* Eviction statistics. */
+static long long evict_cnt;        /* Frames evicted. */
+static long long evict_clean_cnt;  /* ...that needed no write-back. */
+static long long clock_scan_cnt;   /* Frames looked at by the hand. */
+static long long clock_ref_cnt;    /* Second chances given. */
+static long long cow_share_cnt;    /* Pages shared by fork. */
+static long long cow_copy_cnt;     /* Shared pages copied on write. */
+static long long reclaim_wake_cnt; /* Reclaim thread wakeups. */
+static long long reclaim_cnt;      /* Frames it freed. */
+static long long direct_cnt;       /* Faults that had to evict. */
+static long long frame_fail_cnt;   /* ...and found nothing to evict. */
+static long long zero_map_cnt;     /* Read faults given the zero frame. */
+static long long zero_break_cnt;   /* ...that were later written. */
+
 /* 해시 테이블 */
 static uint64_t spt_hash(const struct hash_elem *e, void *aux) {
   const struct page *p = hash_entry(e, struct page, spt_elem);
@@ -44,6 +90,33 @@ void vm_init(void) {
   /* TODO: Your code goes here. */
   list_init(&frame_table);
   lock_init(&frame_lock);
+  lock_set_name(&frame_lock, "frame_lock");
+  clock_hand = NULL;
+
+  /* 워터마크: 사용자 풀의 1/64 아래로 내려가면 깨어나 1/32까지 비운다 */
+  user_frame_cnt = palloc_free_cnt(PAL_USER);
+  reclaim_low = user_frame_cnt / 64;
+  reclaim_high = 2 * reclaim_low;
+  sema_init(&reclaim_sema, 0);
+  if (reclaim_low > 0)
+    thread_create("reclaimd", PRI_DEFAULT, reclaim_thread, NULL);
+
+  zero_kva = palloc_get_page(PAL_ASSERT | PAL_ZERO);
+}
+
+/* Prints eviction statistics. */
+void vm_print_stats(void) {
+  printf("VM: %lld evictions (%lld clean), %lld frames scanned, "
+         "%lld second chances\n",
+         evict_cnt, evict_clean_cnt, clock_scan_cnt, clock_ref_cnt);
+  printf("VM: %lld pages shared copy-on-write, %lld copied\n", cow_share_cnt,
+         cow_copy_cnt);
+  printf("VM: %lld reclaim wakeups, %lld frames reclaimed, "
+         "%lld direct evictions, %lld failed\n",
+         reclaim_wake_cnt, reclaim_cnt, direct_cnt, frame_fail_cnt);
+  printf("VM: %lld zero-page maps, %lld later written\n", zero_map_cnt,
+         zero_break_cnt);
+  swap_print_stats();
 }
 
 /* Get the type of the page. This function is useful if you want to know the
@@ -62,7 +135,15 @@ enum vm_type page_get_type(struct page *page) {
 /* Helpers */
 static struct frame *vm_get_victim(void);
 static bool vm_do_claim_page(struct page *page);
-static struct frame *vm_evict_frame(void);
+static bool vm_wait_claimed(struct page *page);
+static bool vm_map_zero(struct page *page);
+static size_t vm_evict_frames(struct frame **frames, size_t cnt);
+static void frame_table_insert(struct frame *frame);
+static void frame_table_remove(struct frame *frame);
+static struct frame *clock_advance(void);
+static bool frame_test_accessed(struct frame *frame);
+static void frame_unshare(struct frame *frame, struct page *page);
+static bool spt_share_anon(struct page *parent);
 void spt_destructor(struct hash_elem *e, void *aux);
 
 /* Create the pending page object with initializer. If you want to create a
@@ -73,7 +154,7 @@ bool vm_alloc_page_with_initializer(enum vm_type type, void *upage,
                                     void *aux) {
   ASSERT(VM_TYPE(type) != VM_UNINIT)
 
-  struct supplemental_page_table *spt = &thread_current()->spt;
+  struct supplemental_page_table *spt = &thread_current()->proc->spt;
   // 현재 스레드의 spt에 대한 포인터를 얻는다.
 
   /* Check wheter the upage is already occupied or not. */
@@ -107,7 +188,7 @@ bool vm_alloc_page_with_initializer(enum vm_type type, void *upage,
 
     uninit_new(page, upage, init, type, aux, initializer);
     // uninit_new 함수를 사용하여 페이지를 초기화한다.
-    page->owner = thread_current();
+    page->owner = thread_current()->proc;
     page->writable = writable;
 
     if (!spt_insert_page(spt, page)) {
@@ -145,81 +226,276 @@ void spt_remove_page(struct supplemental_page_table *spt, struct page *page) {
   vm_dealloc_page(page);
 }
 
-/* Get the struct frame, that will be evicted. */
+/* Adds FRAME to the frame table just behind the clock hand, so
+   that it is the last frame the hand reaches.  frame_lock must be
+   held. */
+static void frame_table_insert(struct frame *frame) {
+  if (clock_hand == NULL)
+    list_push_back(&frame_table, &frame->frame_elem);
+  else
+    list_insert(clock_hand, &frame->frame_elem);
+  frame->in_table = true;
+}
+
+/* Removes FRAME from the frame table, moving the clock hand past
+   it first if needed.  frame_lock must be held. */
+static void frame_table_remove(struct frame *frame) {
+  if (clock_hand == &frame->frame_elem) clock_advance();
+  list_remove(&frame->frame_elem);
+  frame->in_table = false;
+}
+
+/* Returns the frame under the clock hand and moves the hand to
+   the next one, wrapping around at the end of the table.
+   frame_lock must be held and the table must not be empty. */
+static struct frame *clock_advance(void) {
+  if (clock_hand == NULL) clock_hand = list_begin(&frame_table);
+  struct frame *frame = list_entry(clock_hand, struct frame, frame_elem);
+  clock_hand = list_next(clock_hand);
+  if (clock_hand == list_end(&frame_table)) clock_hand = NULL;
+  return frame;
+}
+
+/* Returns true if any page mapping FRAME has been accessed since
+   the last call, clearing the accessed bits as it goes. */
+static bool frame_test_accessed(struct frame *frame) {
+  bool accessed = false;
+  struct page *page = frame->page;
+  struct list_elem *e = list_begin(&frame->cow_pages);
+
+  for (;;) {
+    uint64_t *pml4 = page->owner != NULL ? page->owner->pml4 : NULL;
+    if (pml4 != NULL && pml4_is_accessed(pml4, page->va)) {
+      pml4_set_accessed(pml4, page->va, false);
+      accessed = true;
+    }
+    if (e == list_end(&frame->cow_pages)) break;
+    page = list_entry(e, struct page, cow_elem);
+    e = list_next(e);
+  }
+  return accessed;
+}
+
+/* FRAME의 페이지를 쫓아낼 때 되써야 할 내용이 없는지. 더럽지 않은
+   파일 페이지만 해당한다. 익명 페이지는 항상 스왑에 써야 한다. */
+static bool frame_is_clean(struct frame *frame, uint64_t *pml4) {
+  struct page *page = frame->page;
+  if (page->operations->type != VM_FILE) return false;
+  return pml4 == NULL || !pml4_is_dirty(pml4, page->va);
+}
+
+/* Get the struct frame, that will be evicted.
+
+   Second-chance clock over frame_table: a frame whose accessed
+   bit is set has the bit cleared and is passed over.  The first
+   unreferenced clean frame is taken at once; the first
+   unreferenced dirty one is only taken if the next
+   CLOCK_CLEAN_WINDOW frames hold nothing clean, so that a clean
+   page is preferred without sweeping the whole table on every
+   eviction.  The hand clears every accessed bit it passes, so two
+   turns only come up empty if pages keep being touched
+   meanwhile, in which case we take the next frame under the
+   hand. */
 static struct frame *vm_get_victim(void) {
-  // struct frame *victim = NULL;
-  /* TODO: The policy for eviction is up to you. */
   ASSERT(!list_empty(&frame_table));
-  struct list_elem *e = list_begin(&frame_table);
-  while (e != list_end(&frame_table)) {
-    struct frame *cand = list_entry(e, struct frame, frame_elem);
-    e = list_next(e);
-    if (cand->page != NULL) {
-      list_remove(&cand->frame_elem);
-      cand->in_table = false;
-      return cand;
+  size_t frame_cnt = list_size(&frame_table);
+  struct frame *victim = NULL;
+  size_t window = 0;
+  bool clean = false;
+
+  for (size_t i = 0; i < 2 * frame_cnt; i++) {
+    if (victim != NULL && window++ >= CLOCK_CLEAN_WINDOW) break;
+    struct frame *cand = clock_advance();
+    clock_scan_cnt++;
+
+    if (cand->page == NULL || cand->pin_cnt > 0) continue;
+    if (frame_test_accessed(cand)) {
+      clock_ref_cnt++;
+      continue;
+    }
+    struct thread *owner = cand->page->owner;
+    uint64_t *pml4 = owner != NULL ? owner->pml4 : NULL;
+    if (frame_is_clean(cand, pml4)) {
+      victim = cand;
+      clean = true;
+      break;
     }
+    if (victim == NULL) victim = cand;
   }
-  return NULL;
-}
 
-/* Evict one page and return the corresponding frame.
- * Return NULL on error.*/
-static struct frame *vm_evict_frame(void) {
-  struct frame *victim UNUSED = vm_get_victim();
-  /* TODO: swap out the victim and return the evicted frame. */
+  // 두 바퀴 동안 모든 페이지가 다시 접근됨: 손 아래 프레임을 고른다.
+  for (size_t i = 0; victim == NULL && i < frame_cnt; i++) {
+    struct frame *cand = clock_advance();
+    if (cand->page != NULL && cand->pin_cnt == 0) victim = cand;
+  }
   if (victim == NULL) return NULL;
-  struct page *page = victim->page;
-  ASSERT(page != NULL);
 
-  if (!swap_out(page)) {
-    list_push_back(&frame_table, &victim->frame_elem);
-    victim->in_table = true;
-    return NULL;
+  evict_cnt++;
+  if (clean) evict_clean_cnt++;
+  frame_table_remove(victim);
+  return victim;
+}
+
+/* Clears the mappings of every page that uses FRAME, so that
+   nothing writes to it while it is being swapped out, or, if MAP,
+   sets them up again after a failed swap-out.  frame_lock must be
+   held. */
+static void frame_set_mapped(struct frame *frame, bool map) {
+  struct page *page = frame->page;
+  struct list_elem *e = list_begin(&frame->cow_pages);
+
+  for (;;) {
+    uint64_t *pml4 = page->owner != NULL ? page->owner->pml4 : NULL;
+    if (pml4 != NULL && !map) {
+      pml4_clear_page(pml4, page->va);
+    } else if (pml4 != NULL) {
+      // 다시 매핑하면 PTE가 새로 써지므로 dirty 비트는 옮겨 둔다
+      bool dirty = pml4_is_dirty(pml4, page->va);
+      pml4_set_page(pml4, page->va, frame->kva, page->writable && !page->cow);
+      if (dirty) pml4_set_dirty(pml4, page->va, true);
+    }
+    if (e == list_end(&frame->cow_pages)) break;
+    page = list_entry(e, struct page, cow_elem);
+    e = list_next(e);
   }
+}
 
-  if (page->owner && page->owner->pml4) {
-    pml4_clear_page(page->owner->pml4, page->va);
+/* Detaches the pages from FRAME once its contents are swapped
+   out.  frame_lock must be held. */
+static void frame_detach(struct frame *frame) {
+  struct page *page = frame->page;
+
+  /* copy-on-write로 공유 중이던 페이지들은 같은 스왑 슬롯을 가리키게
+     하고, 각자 다시 폴트할 때 따로 읽어 들인다. */
+  while (!list_empty(&frame->cow_pages)) {
+    struct page *sharer = list_entry(list_pop_front(&frame->cow_pages),
+                                     struct page, cow_elem);
+    anon_share_slot(page, sharer);
+    sharer->frame = NULL;
+    sharer->cow = false;
   }
 
   page->frame = NULL;
-  victim->page = NULL;
-  return victim;
+  page->cow = false;
+  frame->page = NULL;
+}
+
+/* Evicts up to CNT frames, storing them in FRAMES, and returns how
+   many were evicted.
+
+   The victims are chosen and unmapped in one pass under
+   frame_lock, then swapped out with the lock released, so that
+   other faults and evictions go on during the I/O.  Until a
+   victim is done its page still points to it while it is out of
+   frame_table, which vm_wait_claimed() and vm_wait_evicted() take
+   as "in flight". */
+static size_t vm_evict_frames(struct frame **frames, size_t cnt) {
+  size_t picked = 0, evicted = 0;
+
+  lock_acquire(&frame_lock);
+  while (picked < cnt && !list_empty(&frame_table)) {
+    struct frame *victim = vm_get_victim();
+    if (victim == NULL) break;
+    frame_set_mapped(victim, false);
+    frames[picked++] = victim;
+  }
+  lock_release(&frame_lock);
+
+  for (size_t i = 0; i < picked; i++) {
+    struct frame *victim = frames[i];
+    bool ok = swap_out(victim->page);
+
+    lock_acquire(&frame_lock);
+    if (ok) {
+      frame_detach(victim);
+      frames[evicted++] = victim;
+    } else {
+      frame_set_mapped(victim, true);
+      frame_table_insert(victim);
+    }
+    cond_broadcast(&victim->settled, &frame_lock);
+    lock_release(&frame_lock);
+  }
+  return evicted;
 }
 
-/* palloc()으로 프레임(frame)을 획득한다. 사용 가능한 페이지가 없으면,
- * 페이지를 축출(evict)하고 반환한다. 이 함수는 항상 유효한 주소를 반환한다.
- * 즉, 사용자 풀(user pool) 메모리가 가득 찬 경우, 이 함수는 프레임을
- * 축출하여 사용 가능한 메모리 공간을 확보한다. */
+/* Number of free user frames.  frame_lock must be held. */
+static size_t free_frame_cnt(void) {
+  return user_frame_cnt - used_frame_cnt;
+}
+
+/* Evicts frames in batches of RECLAIM_BATCH whenever woken, until
+   reclaim_high frames are free or nothing more can be evicted, and
+   gives them back to the user pool. */
+static void reclaim_thread(void *aux UNUSED) {
+  struct frame *frames[RECLAIM_BATCH];
+
+  for (;;) {
+    sema_down(&reclaim_sema);
+    reclaim_wake_cnt++;
+
+    lock_acquire(&frame_lock);
+    while (free_frame_cnt() < reclaim_high) {
+      lock_release(&frame_lock);
+      size_t cnt = vm_evict_frames(frames, RECLAIM_BATCH);
+      for (size_t i = 0; i < cnt; i++) {
+        palloc_free_page(frames[i]->kva);
+        free(frames[i]);
+      }
+      lock_acquire(&frame_lock);
+      used_frame_cnt -= cnt;
+      reclaim_cnt += cnt;
+      if (cnt == 0) break;
+    }
+    reclaim_pending = false;
+    lock_release(&frame_lock);
+  }
+}
+
+/* palloc()으로 프레임(frame)을 획득한다. 여유 프레임이 reclaim_low
+ * 아래로 내려가면 reclaim 쓰레드를 깨운다. 예비분까지 바닥났으면 직접
+ * 페이지를 축출(evict)하고 반환한다. 쫓아낼 프레임도 없으면(모두 고정돼
+ * 있거나 스왑이 가득 참) NULL을 돌려주고, 호출자는 폴트를 실패시켜
+ * 프로세스를 종료시킨다. */
 
 static struct frame *vm_get_frame(void) {
   struct frame *frame = NULL;
-  /* TODO: Fill this function. */
 
   lock_acquire(&frame_lock);
-
   // 물리페이지 획득
   void *kernal_va = palloc_get_page(PAL_USER);
+  if (kernal_va != NULL) used_frame_cnt++;
+  if (free_frame_cnt() < reclaim_low && !reclaim_pending) {
+    reclaim_pending = true;
+    sema_up(&reclaim_sema);
+  }
+  lock_release(&frame_lock);
+
   if (kernal_va != NULL) {
     // 프레임구조체 생성 및 초기화
     frame = malloc(sizeof(struct frame));
-    if (frame == NULL) PANIC("to do");
+    if (frame == NULL) {
+      lock_acquire(&frame_lock);
+      used_frame_cnt--;
+      frame_fail_cnt++;
+      lock_release(&frame_lock);
+      palloc_free_page(kernal_va);
+      return NULL;
+    }
     frame->kva = kernal_va;
-    frame->page = NULL;
-    frame->in_table = false;
-    // list_push_back(&frame_table, &frame->frame_elem);
-    // frame->in_table = true;
-
   } else {
-    frame = vm_evict_frame();
-    if (frame == NULL) PANIC("to do");
-    frame->page = NULL;
-    frame->in_table = false;
-    // list_push_back(&frame_table, &frame->frame_elem);
-    // frame->in_table = true;
+    direct_cnt++;
+    if (vm_evict_frames(&frame, 1) == 0) {
+      frame_fail_cnt++;
+      return NULL;
+    }
   }
-
-  lock_release(&frame_lock);
+  frame->page = NULL;
+  frame->in_table = false;
+  list_init(&frame->cow_pages);
+  cond_init(&frame->settled);
+  frame->pin_cnt = 0;
+  frame->free_on_unpin = false;
   return frame;
 }
 
@@ -241,21 +517,157 @@ static void vm_stack_growth(void *addr) {
 }
 
 /* Handle the fault on write_protected page */
-static bool vm_handle_wp(struct page *page UNUSED) {}
+static bool vm_handle_wp(struct page *page) {
+  if (!page->writable) return false;
+  if (page->zero) return vm_zero_break(page);
+  return vm_cow_break(page);
+}
+
+/* Returns true if PAGE is anonymous memory that has never been
+   touched, that is, reads as all zeros. */
+static bool page_is_zero_fill(struct page *page) {
+  return page->operations->type == VM_UNINIT &&
+         VM_TYPE(page->uninit.type) == VM_ANON && page->uninit.init == NULL;
+}
+
+/* Maps the zero frame read-only at PAGE if PAGE is untouched
+   anonymous memory, so that reading it takes no frame.  The first
+   write gets PAGE a frame of its own through vm_zero_break().
+   Returns false if PAGE has to be claimed instead. */
+static bool vm_map_zero(struct page *page) {
+  struct thread *cur = thread_current();
+  bool mapped = false;
+
+  if (!page_is_zero_fill(page)) return false;
+
+  lock_acquire(&frame_lock);
+  // 다른 쓰레드가 그 사이 올리기 시작했으면 그쪽을 따른다
+  if (page->frame == NULL && page_is_zero_fill(page) &&
+      pml4_set_page(cur->pml4, page->va, zero_kva, false)) {
+    page->zero = true;
+    mapped = true;
+    zero_map_cnt++;
+  }
+  lock_release(&frame_lock);
+
+  if (mapped) cur->ru.minflt++;
+  return mapped;
+}
+
+/* Gives PAGE, which is mapped to the zero frame, a private
+   writable frame.  Returns false if no memory is left. */
+bool vm_zero_break(struct page *page) {
+  if (vm_wait_claimed(page)) return true;
+  return vm_do_claim_page(page);
+}
+
+/* Removes PAGE from the pages sharing FRAME.  If PAGE was FRAME's
+   primary page, the next sharer takes its place.  frame_lock must
+   be held and FRAME must be shared. */
+static void frame_unshare(struct frame *frame, struct page *page) {
+  ASSERT(!list_empty(&frame->cow_pages));
+  if (frame->page == page)
+    frame->page =
+        list_entry(list_pop_front(&frame->cow_pages), struct page, cow_elem);
+  else
+    list_remove(&page->cow_elem);
+  page->frame = NULL;
+}
+
+/* Detaches PAGE from its frame if the frame is shared with other
+   pages, and returns true.  Returns false, changing nothing, if
+   PAGE is the frame's only user, in which case the caller frees
+   the frame as usual.  The caller clears PAGE's mapping. */
+bool vm_frame_unshare(struct page *page) {
+  bool shared = false;
+
+  lock_acquire(&frame_lock);
+  struct frame *frame = page->frame;
+  if (frame != NULL && !list_empty(&frame->cow_pages)) {
+    frame_unshare(frame, page);
+    shared = true;
+  }
+  lock_release(&frame_lock);
+  return shared;
+}
+
+/* Gives copy-on-write PAGE a private, writable frame.  If PAGE
+   turns out to be the last user of its frame, the frame is just
+   mapped writable again.  Returns false if no memory is left.
+
+   The mapping is cleared before it is set again so that the stale
+   read-only TLB entry is flushed. */
+bool vm_cow_break(struct page *page) {
+  uint64_t *pml4 = page->owner->pml4;
+  struct frame *copy = NULL;
+
+  lock_acquire(&frame_lock);
+  for (;;) {
+    struct frame *frame = page->frame;
+
+    /* 그 사이 쫓겨났거나 쫓겨나는 중이면 다음 접근 때 제 프레임으로
+       올라온다. */
+    if (frame == NULL || !frame->in_table || !page->cow) break;
+
+    if (list_empty(&frame->cow_pages)) {
+      page->cow = false;
+      pml4_clear_page(pml4, page->va);
+      pml4_set_page(pml4, page->va, frame->kva, page->writable);
+      break;
+    }
+
+    if (copy == NULL) {
+      /* 프레임 확보는 frame_lock을 잡으므로 놓고 받아 온 뒤 다시 확인 */
+      lock_release(&frame_lock);
+      copy = vm_get_frame();
+      if (copy == NULL) return false;
+      lock_acquire(&frame_lock);
+      continue;
+    }
+
+    memcpy(copy->kva, frame->kva, PGSIZE);
+    frame_unshare(frame, page);
+    copy->page = page;
+    page->frame = copy;
+    page->cow = false;
+    pml4_clear_page(pml4, page->va);
+    if (!pml4_set_page(pml4, page->va, copy->kva, page->writable)) {
+      copy->page = NULL;
+      page->frame = NULL;
+      lock_release(&frame_lock);
+      vm_free_frame(copy);
+      return false;
+    }
+    frame_table_insert(copy);
+    copy = NULL;
+    cow_copy_cnt++;
+    break;
+  }
+  lock_release(&frame_lock);
+
+  if (copy != NULL) vm_free_frame(copy);
+  thread_current()->ru.minflt++;
+  return true;
+}
 
 /* Return true on success */
 bool vm_try_handle_fault(struct intr_frame *f, void *addr, bool user,
                          bool write, bool not_present) {
-  // 보호 위반은 skip
-  if (!not_present) return false;
-
   // 커널 주소/NULL은 거부
   if (addr == NULL || is_kernel_vaddr(addr)) return false;
 
+  // 보호 위반: copy-on-write 페이지에 쓴 경우만 처리
+  if (!not_present) {
+    if (!write) return false;
+    struct page *page =
+        spt_find_page(&thread_current()->proc->spt, pg_round_down(addr));
+    return page != NULL && vm_handle_wp(page);
+  }
+
   void *upage = pg_round_down(addr);
 
   // SPT에서 해당 페이지 찾기 (load_segment 때 등록된 uninit/file 페이지)
-  struct supplemental_page_table *spt = &thread_current()->spt;
+  struct supplemental_page_table *spt = &thread_current()->proc->spt;
   struct page *page = spt_find_page(spt, upage);
 
   if (page == NULL) {
@@ -283,6 +695,9 @@ bool vm_try_handle_fault(struct intr_frame *f, void *addr, bool user,
 
   if (write && !page->writable) return false;
 
+  if (vm_wait_claimed(page)) return true;
+  // 아직 손대지 않은 익명 페이지를 읽기만 하면 제로 프레임을 매핑한다
+  if (!write && vm_map_zero(page)) return true;
   return vm_do_claim_page(page);
 }
 
@@ -297,36 +712,119 @@ void vm_dealloc_page(struct page *page) {
 bool vm_claim_page(void *va UNUSED) {
   struct page *page = NULL;
   va = pg_round_down(va);
-  page = spt_find_page(&thread_current()->spt, va);
+  page = spt_find_page(&thread_current()->proc->spt, va);
   if (!page) return false;
+  if (vm_wait_claimed(page)) return true;
   return vm_do_claim_page(page);
 }
 
+/* Waits, holding frame_lock, until PAGE's frame is neither being
+   claimed nor being evicted.  Blocks on the frame's condition
+   rather than yielding, since the thread doing the I/O may have a
+   lower priority than the caller.  Returns PAGE's frame, or NULL
+   if PAGE has none. */
+static struct frame *frame_wait_settled(struct page *page) {
+  struct frame *frame;
+
+  ASSERT(lock_held_by_current_thread(&frame_lock));
+  while ((frame = page->frame) != NULL && !frame->in_table)
+    cond_wait(&frame->settled, &frame_lock);
+  return frame;
+}
+
+/* 같은 프로세스의 다른 쓰레드가 PAGE를 올리는(또는 쫓아내는) 중이면
+   끝날 때까지 기다린다. 올리기가 끝났으면 (frame이 frame_table에 들어가
+   매핑돼 있으면) true, 아니면 false를 돌려주고 호출자가 직접 claim한다. */
+static bool vm_wait_claimed(struct page *page) {
+  uint64_t *pml4 = thread_current()->pml4;
+
+  lock_acquire(&frame_lock);
+  bool claimed = frame_wait_settled(page) != NULL &&
+                 pml4_get_page(pml4, page->va) != NULL;
+  lock_release(&frame_lock);
+
+  if (claimed) thread_current()->ru.minflt++;
+  return claimed;
+}
+
+/* Waits until no eviction of PAGE's frame is in progress, so that
+   the caller can tear PAGE down. */
+void vm_wait_evicted(struct page *page) {
+  lock_acquire(&frame_lock);
+  frame_wait_settled(page);
+  lock_release(&frame_lock);
+}
+
 void vm_free_frame(struct frame *frame) {
   ASSERT(frame != NULL);
+  ASSERT(frame->page == NULL);
   lock_acquire(&frame_lock);
-  if (frame->in_table) {
-    list_remove(&frame->frame_elem);
-    frame->in_table = false;
+  if (frame->in_table) frame_table_remove(frame);
+  cond_broadcast(&frame->settled, &frame_lock);
+  // 커널이 kva로 쓰는 중이면 vm_unpin_frame()이 마저 해제한다
+  if (frame->pin_cnt > 0) {
+    frame->free_on_unpin = true;
+    lock_release(&frame_lock);
+    return;
   }
+  used_frame_cnt--;
   lock_release(&frame_lock);
-  ASSERT(frame->page == NULL);
   palloc_free_page(frame->kva);
   free(frame);
 }
 
+/* Pins the frame holding PAGE, which must belong to the current
+   process, so that it is not evicted while the kernel reads or
+   writes it through its kva, and returns it.  Returns NULL if
+   PAGE is not in a frame right now.  Unpin with
+   vm_unpin_frame(). */
+struct frame *vm_pin_page(struct page *page) {
+  lock_acquire(&frame_lock);
+  struct frame *frame = frame_wait_settled(page);
+  if (frame != NULL) frame->pin_cnt++;
+  lock_release(&frame_lock);
+  return frame;
+}
+
+/* Undoes vm_pin_page(). */
+void vm_unpin_frame(struct frame *frame) {
+  lock_acquire(&frame_lock);
+  ASSERT(frame->pin_cnt > 0);
+  bool release = --frame->pin_cnt == 0 && frame->free_on_unpin;
+  if (release) used_frame_cnt--;
+  lock_release(&frame_lock);
+
+  if (release) {
+    palloc_free_page(frame->kva);
+    free(frame);
+  }
+}
+
 /* Claim the PAGE and set up the mmu. */
 static bool vm_do_claim_page(struct page *page) {
+  uint64_t inblock = thread_current()->ru.inblock;
   struct frame *frame = vm_get_frame();
+  if (frame == NULL) return false;
 
   /* Set links */
   frame->page = page;
   page->frame = frame;
 
-  if (page->owner == NULL) page->owner = thread_current();
+  if (page->owner == NULL) page->owner = thread_current()->proc;
 
   /* TODO: Insert page table entry to map page's VA to frame's PA. */
   struct thread *cur = thread_current();
+
+  /* 제로 프레임 매핑은 지워서 읽기 전용 TLB 항목까지 비운다 */
+  if (page->zero) {
+    lock_acquire(&frame_lock);
+    if (page->zero) {
+      pml4_clear_page(cur->pml4, page->va);
+      page->zero = false;
+      zero_break_cnt++;
+    }
+    lock_release(&frame_lock);
+  }
   if (!pml4_set_page(cur->pml4, page->va, frame->kva, page->writable))
     goto fail;
 
@@ -336,12 +834,15 @@ static bool vm_do_claim_page(struct page *page) {
   }
 
   lock_acquire(&frame_lock);
-  if (!frame->in_table) {
-    list_push_back(&frame_table, &frame->frame_elem);
-    frame->in_table = true;
-  }
+  if (!frame->in_table) frame_table_insert(frame);
+  cond_broadcast(&frame->settled, &frame_lock);
   lock_release(&frame_lock);
 
+  // 디스크에서 읽어 와야 했으면 major fault
+  if (cur->ru.inblock != inblock)
+    cur->ru.majflt++;
+  else
+    cur->ru.minflt++;
   return true;
 fail:
   frame->page = NULL;
@@ -404,8 +905,15 @@ bool supplemental_page_table_copy(struct supplemental_page_table *dst UNUSED,
         supplemental_page_table_kill(dst);
         return false;
       }
+    } else if (type == VM_ANON) {
+      // 익명 페이지는 프레임이나 스왑 슬롯을 copy-on-write로 공유한다
+      if (!spt_share_anon(parent_page)) {
+        supplemental_page_table_kill(dst);
+        return false;
+      }
+      continue;
     } else {
-      // ANON 또는 FILE 페이지 처리
+      // FILE 페이지 처리
       if (!vm_alloc_page(type, upage, writable)) {
         supplemental_page_table_kill(dst);
         return false;
@@ -430,6 +938,50 @@ bool supplemental_page_table_copy(struct supplemental_page_table *dst UNUSED,
   return true;
 }
 
+/* Adds to the current process's SPT an anonymous page at
+   PARENT's address that shares PARENT's frame, or its swap slot,
+   copy-on-write.  Both pages stay mapped read-only until one of
+   them is written; see vm_cow_break(). */
+static bool spt_share_anon(struct page *parent) {
+  struct thread *cur = thread_current();
+  bool ok = true;
+
+  if (!vm_alloc_page(VM_ANON, parent->va, parent->writable)) return false;
+  struct page *child = spt_find_page(&cur->proc->spt, parent->va);
+  // 내용은 부모 것을 쓰므로 지연 로딩 없이 바로 익명 페이지로 만든다
+  anon_initializer(child, VM_ANON, NULL);
+
+  lock_acquire(&frame_lock);
+  for (;;) {
+    struct frame *frame = parent->frame;
+    if (frame == NULL) {
+      anon_share_slot(parent, child);
+      break;
+    }
+    if (frame->in_table) {
+      if (!pml4_set_page(cur->pml4, child->va, frame->kva, false)) {
+        ok = false;
+        break;
+      }
+      if (!parent->cow) {
+        uint64_t *pml4 = parent->owner->pml4;
+        pml4_clear_page(pml4, parent->va);
+        pml4_set_page(pml4, parent->va, frame->kva, false);
+        parent->cow = true;
+      }
+      list_push_back(&frame->cow_pages, &child->cow_elem);
+      child->frame = frame;
+      child->cow = true;
+      cow_share_cnt++;
+      break;
+    }
+    // 부모의 다른 쓰레드가 올리는 중이면 끝날 때까지 기다린다
+    frame_wait_settled(parent);
+  }
+  lock_release(&frame_lock);
+  return ok;
+}
+
 /* Free the resource hold by the supplemental page table */
 void supplemental_page_table_kill(struct supplemental_page_table *spt UNUSED) {
   /* TODO: Destroy all the supplemental_page_table hold by thread and